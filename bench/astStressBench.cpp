@@ -0,0 +1,73 @@
+#include "compiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Compiles generated programs at the extremes of size and nesting, to make sure every pass scales to them without running out of stack or going quadratic.
+// Usage: AstStressBench [statements] [depth]
+
+// Make a function whose body is one huge block. Every other statement is a dead assignment, so dead code elimination removes half the block.
+// statements: Number of statements in the block.
+// Returns: The source code.
+static std::string MakeLongBlock(size_t statements)
+{
+    std::string source = "int f() {\n    int a;\n    int b;\n    a = 0;\n";
+    for (size_t i = 0; i < statements / 2; i++) source += "    a = a + 1;\n    b = a;\n";
+    source += "    return a;\n}";
+    return source;
+}
+
+// Make a function with statements nested inside each other, alternating between ifs with an else branch and while loops.
+// depth: Number of levels of nesting.
+// Returns: The source code.
+static std::string MakeNestedStatements(size_t depth)
+{
+    std::string source = "int f(int a) {\n";
+    for (size_t i = 0; i < depth; i++) source += i % 2 ? "while (a < 10) {\n" : "if (a > 0) {\n";
+    source += "a = a + 1;\n";
+    for (size_t i = depth; i-- > 0;) source += i % 2 ? "}\n" : "} else {\na = a - 1;\n}\n";
+    source += "return a;\n}";
+    return source;
+}
+
+// Make a function returning one expression nested inside itself.
+// depth: Number of levels of nesting.
+// Returns: The source code.
+static std::string MakeNestedExpression(size_t depth)
+{
+    std::string source = "int f(int a) {\n    return ";
+    source.append(depth, '(');
+    source += "a";
+    for (size_t i = 0; i < depth; i++) source += i % 2 ? " - 1)" : " + 2)";
+    source += ";\n}";
+    return source;
+}
+
+// Compile a program and report how it went.
+// name: Name of the program.
+// source: Source code to compile.
+// printAst: If to print the AST too. The lines drawn down to each node make printed trees grow with the square of their depth, so this is only worth it for shallow ones.
+// Returns: If compilation succeeded.
+static bool Measure(const char* name, const std::string& source, bool printAst)
+{
+    CompileOptions options;
+    options.printAst = printAst;
+    auto start = std::chrono::steady_clock::now();
+    CompileResult result = CompileSource(source, options);
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    printf("%-20s %8.2f s, %s\n", name, time.count(), result.success ? "ok" : "FAILED");
+    if (!result.success) printf("%s", result.diagnostics.c_str());
+    return result.success;
+}
+
+int main(int argc, char** argv)
+{
+    size_t statements = argc > 1 ? atoi(argv[1]) : 1000000;
+    size_t depth = argc > 2 ? atoi(argv[2]) : 10000;
+    bool success = Measure("long block:", MakeLongBlock(statements), true);
+    success &= Measure("nested statements:", MakeNestedStatements(depth), false);
+    success &= Measure("nested expression:", MakeNestedExpression(depth), false);
+    return success ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "frontend/charScan.h"
+#include "frontend/parseContext.h"
+#include "parser.tab.hh"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Measures how fast the lexer's character scans get through large inputs, with the vector fast path and a byte at a time.
+// The scans are timed on their own, then the whole lexer is run over a large generated program both ways.
+// Usage: CharScanBench [megabytes]
+
+// Scanner state handle, same as the one flex defines.
+typedef void* yyscan_t;
+
+// These are defined in the generated lexer.
+yyscan_t LexerBegin(ParseChunk& chunk);
+void LexerEnd(yyscan_t scanner);
+int yylex(yy::parser::value_type* yylval_param, yyscan_t yyscanner);
+
+// Make input made of runs for a scan to skip, each ended by a character that stops it.
+// size: Rough size of the input in bytes.
+// run: Character the runs are made of.
+// stop: Character that ends each run.
+// Returns: The input. Its string terminator stops every scan, like the null bytes at the end of a lexer buffer.
+static std::string MakeInput(size_t size, char run, char stop)
+{
+    std::string input;
+    input.reserve(size + 64);
+    srand(337);
+    while (input.size() < size)
+    {
+        input.append(rand() % 64 + 1, run);
+        input.push_back(stop);
+    }
+    return input;
+}
+
+// Run a scan over the whole input, restarting after every run.
+// input: Input to scan.
+// scan: Scan to run.
+// Returns: Throughput in megabytes per second.
+template <typename Scan>
+static double Measure(const std::string& input, Scan scan)
+{
+    const int REPEATS = 10;
+    const char* end = input.data() + input.size();
+    size_t runs = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < REPEATS; i++)
+    {
+        for (const char* text = input.data(); text < end; text = scan(text) + 1) runs++;
+    }
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    if (runs == 0) printf("No runs found!\n"); // Keeps the loop from being optimized out.
+    return input.size() * (double)REPEATS / time.count() / (1024 * 1024);
+}
+
+// Make a program for the lexer, made of functions like people write them: indented statements with a string literal now and then.
+// size: Rough size of the program in bytes.
+// Returns: The source code.
+static std::string MakeProgram(size_t size)
+{
+    std::string source = "int printf(string fmt, ...);\n\n";
+    source.reserve(size + 1024);
+    srand(337);
+    for (size_t func = 0; source.size() < size; func++)
+    {
+        std::string name = "f" + std::to_string(func);
+        source += "int " + name + "(int a, float b)\n{\n    int i;\n    int total;\n    total = 0;\n";
+        for (int i = rand() % 32 + 8; i > 0; i--)
+        {
+            switch (rand() % 4)
+            {
+                case 0: source += "    total = total + a * " + std::to_string(rand() % 1000) + ";\n"; break;
+                case 1: source += "    if (total > " + std::to_string(rand() % 100) + " && a != 0)\n    {\n        total = total - 1;\n    }\n"; break;
+                case 2: source += "    for (i = 0; i < a; i = i + 1;)\n    {\n        total = total + i;\n    }\n"; break;
+                default: source += "    printf(\"" + name + " has reached a total of %d, which is a fairly long message\\n\", total);\n"; break;
+            }
+        }
+        source += "    return total;\n}\n\n";
+    }
+    return source;
+}
+
+// Lex a whole program, throwing the tokens away.
+// source: Program to lex.
+// scalarScans: If to skip runs a byte at a time instead of with the vector scans.
+// Returns: Throughput in megabytes per second.
+static double MeasureLexer(SourceBuffer& source, bool scalarScans)
+{
+    const int REPEATS = 5;
+    Arena arena;
+    size_t tokens = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < REPEATS; i++)
+    {
+        ParseChunk chunk(source, source.Data(), source.Size(), arena);
+        chunk.scalarScans = scalarScans;
+        yyscan_t scanner = LexerBegin(chunk);
+        while (true)
+        {
+            yy::parser::value_type value; // Token values are trivial, so nothing has to be destroyed.
+            if (yylex(&value, scanner) == 0) break;
+            tokens++;
+        }
+        LexerEnd(scanner);
+    }
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+    if (tokens == 0) printf("No tokens found!\n");
+    return source.Size() * (double)REPEATS / time.count() / (1024 * 1024);
+}
+
+int main(int argc, char** argv)
+{
+    size_t size = (argc > 1 ? atoi(argv[1]) : 64) * (size_t)1024 * 1024;
+    std::string spaces = MakeInput(size, ' ', ';');
+    std::string strings = MakeInput(size, 'a', '"');
+    printf("whitespace:     %8.1f MB/s vector, %8.1f MB/s scalar\n", Measure(spaces, SkipWhitespace), Measure(spaces, SkipWhitespaceScalar));
+    printf("string bodies:  %8.1f MB/s vector, %8.1f MB/s scalar\n", Measure(strings, SkipStringBody), Measure(strings, SkipStringBodyScalar));
+    SourceBuffer program;
+    program.Copy(MakeProgram(size));
+    printf("whole lexer:    %8.1f MB/s vector, %8.1f MB/s scalar\n", MeasureLexer(program, false), MeasureLexer(program, true));
+    return 0;
+}
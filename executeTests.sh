@@ -1,14 +1,72 @@
 # This will run our compiler on a C file, export its LLVM ASM to a .ll file and output how it went to the log.
 # The LLVM ASM is than ran and its outut sent to the execution log.
+# Extra compiler arguments for a test, like -j 4, go in its .args file.
 function runTest {
-    ./run.sh -i new-tests/$1.c -fAsm -o new-tests/$1.ll &> new-tests/$1.log
-    # lli new-tests/$1.ll &> new-tests/$1Execution.log
+    ./run.sh -i new-tests/$1.c -fAsm -o new-tests/$1.ll $(cat new-tests/$1.args 2> /dev/null) &> new-tests/$1.log
+    checkOutput $1
     # llvm-as new-tests/$1.ll -o new-tests/$1.bc &> new-tests/$1Bytecode.log
 }
 
+# If a test has an expected output in its .expected file, run its LLVM ASM and compare what it prints to that.
+function checkOutput {
+    if [ ! -f new-tests/$1.expected ]; then return; fi
+    if lli new-tests/$1.ll &> new-tests/$1Execution.log && cmp -s new-tests/$1.expected new-tests/$1Execution.log; then
+        echo "Passed: $1"
+    else
+        echo "FAILED: $1, see new-tests/$1.log and new-tests/$1Execution.log"
+    fi
+}
+
+# Compile the files of new-tests/link as units of their own and link them into one program.
+function runLinkTest {
+    ./run.sh -i new-tests/link/main.c -i new-tests/link/helper.c -fAsm -o new-tests/link.ll -nPrint &> new-tests/link.log
+    checkOutput link
+}
+
+# Send the compile server a good request, one for an unknown format, and one too large to read, and check each gets its answer.
+function runServerTest {
+    local source='int main() { return 0; }'
+    printf 'COMPILE good asm 0 %d\n%sCOMPILE badFormat wasm 0 %d\n%sCOMPILE tooLarge asm 0 999999999999\n' ${#source} "$source" ${#source} "$source" | ./run.sh --server -j 1 &> new-tests/server.log
+    if grep -q "^RESULT good OK" new-tests/server.log && grep -q "^RESULT badFormat FAIL" new-tests/server.log && grep -q "^RESULT tooLarge FAIL" new-tests/server.log; then
+        echo "Passed: server"
+    else
+        echo "FAILED: server, see new-tests/server.log"
+    fi
+}
+
+# Compile and run a program with ifs nested 100000 levels deep, which is too big to keep around as a file. Every part of the compiler has to get through it without running out of stack, including freeing the AST.
+function runDeepNestingTest {
+    local dir=$(mktemp -d)
+    {
+        echo 'int printf(string fmt, ...);'
+        echo 'int main()'
+        echo '{'
+        echo 'int a;'
+        echo 'a = 0;'
+        for ((i = 0; i < 100000; i++)); do echo 'if (a < 1) {'; done
+        echo 'a = a + 1;'
+        for ((i = 0; i < 100000; i++)); do echo '}'; done
+        echo 'printf("%d\n", a);'
+        echo 'return 0;'
+        echo '}'
+    } > $dir/deepNesting.c
+    if ./run.sh -i $dir/deepNesting.c -fAsm -o $dir/deepNesting.ll -nPrint &> new-tests/deepNesting.log && [ "$(lli $dir/deepNesting.ll)" = "1" ]; then
+        echo "Passed: deepNesting"
+    else
+        echo "FAILED: deepNesting, see new-tests/deepNesting.log"
+    fi
+    rm -rf $dir
+}
+
 # Run all the C file tests.
 for file in "new-tests"/*.c; do
     file=$(basename $file .c)
     echo "Testing: $file"
     runTest $file
-done
\ No newline at end of file
+done
+echo "Testing: link"
+runLinkTest
+echo "Testing: server"
+runServerTest
+echo "Testing: deepNesting"
+runDeepNestingTest
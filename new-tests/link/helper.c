@@ -0,0 +1,15 @@
+int twice(int a)
+{
+    return a + a;
+}
+
+int counter()
+{
+    int i;
+    int n;
+    n = 0;
+    for(i = 0; i < 4; i = i + 1;) {
+        n = n + twice(i);
+    }
+    return n;
+}
@@ -0,0 +1,10 @@
+int printf(string fmt, ...);
+int twice(int a);
+int counter();
+
+int main()
+{
+    printf("%d\n", twice(21));
+    printf("%d\n", counter());
+    return 0;
+}
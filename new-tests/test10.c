@@ -0,0 +1,32 @@
+int printf(string fmt, ...);
+
+int operands(int x)
+{
+    int y;
+    y = (x = 1) + x;
+    return y;
+}
+
+int andSkip(bool flag)
+{
+    int x;
+    x = 5;
+    if(flag && (x = 7) > 0) {}
+    return x;
+}
+
+int orSkip(bool flag)
+{
+    int x;
+    x = 5;
+    if(flag || (x = 7) > 0) {}
+    return x;
+}
+
+int main()
+{
+    printf("%d\n", operands(10));
+    printf("%d %d\n", andSkip(false), andSkip(true));
+    printf("%d %d\n", orSkip(true), orSkip(false));
+    return 0;
+}
@@ -0,0 +1,28 @@
+int printf(string fmt, ...);
+
+int main()
+{
+    int a;
+    int i;
+    int unused;
+    a = 1;
+    if(a > 0) {
+        unused = 1;
+    }
+    else {
+        unused = 2;
+    }
+    i = 0;
+    while(i < 3) {
+        unused = i;
+        i = i + 1;
+    }
+    for(i = 0; i < 3; i = i + 1;) {
+        unused = 5;
+    }
+    if(a < 0) {
+        unused = 3;
+    }
+    printf("%d %d\n", a, i);
+    return 0;
+}
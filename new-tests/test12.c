@@ -0,0 +1,42 @@
+int printf(string fmt, ...);
+
+int second(int a)
+{
+    printf("} not the end of a function {\n");
+    return a * 2;
+}
+
+int first(int a)
+{
+    return second(a) + 1;
+}
+
+int third(int a)
+{
+    int i;
+    int total;
+    total = 0;
+    for(i = 0; i < a; i = i + 1;) {
+        total = total + first(i);
+    }
+    return total;
+}
+
+int fourth(int a)
+{
+    if(a > 10) {
+        return a - 10;
+    }
+    return third(a);
+}
+
+int fifth(int a)
+{
+    return fourth(a) + fourth(a + 20);
+}
+
+int main()
+{
+    printf("%d\n", fifth(3));
+    return 0;
+}
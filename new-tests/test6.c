@@ -0,0 +1,17 @@
+int printf(string fmt, ...);
+
+int f(int a)
+{
+    int x;
+    int y;
+    int z;
+    y = a;
+    z = (x = y + 1);
+    return z;
+}
+
+int main()
+{
+    printf("%d\n", f(41));
+    return 0;
+}
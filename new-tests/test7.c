@@ -0,0 +1,39 @@
+int printf(string fmt, ...);
+
+int edges(bool run)
+{
+    int a;
+    a = 0;
+    if(run) {
+        a = (0 - 2147483647 - 1) / (0 - 1);
+        a = a + 1 / 0;
+    }
+    return a;
+}
+
+int notEqual(float a, float b)
+{
+    int r;
+    r = 0;
+    if(a != b) {
+        r = 1;
+    }
+    return r;
+}
+
+int main()
+{
+    float zero;
+    float nan;
+    int folded;
+    zero = 0.0;
+    nan = zero / zero;
+    folded = 0;
+    if(nan != nan) {
+        folded = 1;
+    }
+    printf("%d\n", edges(false));
+    printf("%d %d\n", folded, notEqual(nan, nan));
+    printf("%d\n", (0 - 2147483647 - 1) + (0 - 1));
+    return 0;
+}
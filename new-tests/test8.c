@@ -0,0 +1,38 @@
+int printf(string fmt, ...);
+
+int pick(bool flag)
+{
+    int a;
+    int b;
+    a = 3;
+    if(flag) {
+        b = a + 1;
+    }
+    else {
+        b = 4;
+    }
+    return b * 2;
+}
+
+int count(int n)
+{
+    int i;
+    int k;
+    int total;
+    k = 5;
+    total = 0;
+    i = 0;
+    while(i < n) {
+        k = 5;
+        total = total + k;
+        i = i + 1;
+    }
+    return total + k;
+}
+
+int main()
+{
+    printf("%d %d\n", pick(true), pick(false));
+    printf("%d\n", count(3));
+    return 0;
+}
@@ -0,0 +1,36 @@
+int printf(string fmt, ...);
+
+int sum()
+{
+    int i;
+    int total;
+    total = 0;
+    for(i = 0; i < 10; i = i + 1;) {
+        if(i < 20) {
+            total = total + i;
+        }
+        else {
+            total = total - 1000;
+        }
+    }
+    return total;
+}
+
+int countdown()
+{
+    int i;
+    int steps;
+    steps = 0;
+    i = 10;
+    while(i > 0) {
+        i = i - 2;
+        steps = steps + 1;
+    }
+    return steps;
+}
+
+int main()
+{
+    printf("%d %d\n", sum(), countdown());
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "arena.h"
+
+// Size of each arena chunk. Bigger allocations get a chunk of their own.
+static const size_t CHUNK_SIZE = 64 * 1024;
+
+// Every allocation is rounded up to this so anything can be stored in it.
+static const size_t ALIGNMENT = alignof(std::max_align_t);
+
+// Arena that allocations on the current thread go to.
+static thread_local Arena* currentArena = nullptr;
+
+// Round a size up to the alignment.
+static size_t Align(size_t size)
+{
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+void* Arena::Allocate(size_t size)
+{
+    size = Align(size);
+    if (size > left)
+    {
+        size_t newSize = size > CHUNK_SIZE ? size : CHUNK_SIZE;
+        chunks.push_back(std::unique_ptr<char[]>(new char[newSize]));
+        pos = chunks.back().get();
+        left = newSize;
+    }
+    void* ret = pos;
+    pos += size;
+    left -= size;
+    return ret;
+}
+
+void Arena::Free(void* ptr, size_t size)
+{
+    size = Align(size);
+    if ((char*)ptr + size == pos) // Last allocation, so we can just roll back.
+    {
+        pos -= size;
+        left += size;
+    }
+}
+
+Arena& Arena::AddChild()
+{
+    children.push_back(std::make_unique<Arena>());
+    return *children.back();
+}
+
+Arena* Arena::Current()
+{
+    return currentArena;
+}
+
+void Arena::SetCurrent(Arena* arena)
+{
+    currentArena = arena;
+}
+
+/*
+    Each object is preceded by a header that remembers which arena it came from, or null if it came from the heap.
+    This way objects can be freed correctly no matter which arena is current at the time, or if none is.
+    The header is a full alignment unit so the object after it stays aligned.
+*/
+static const size_t HEADER_SIZE = Align(sizeof(Arena*));
+
+void* ArenaAllocated::operator new(size_t size)
+{
+    Arena* arena = currentArena;
+    char* mem = arena ? (char*)arena->Allocate(HEADER_SIZE + size) : (char*)::operator new(HEADER_SIZE + size);
+    *(Arena**)mem = arena;
+    return mem + HEADER_SIZE;
+}
+
+void ArenaAllocated::operator delete(void* ptr, size_t size)
+{
+    if (!ptr) return;
+    char* mem = (char*)ptr - HEADER_SIZE;
+    Arena* arena = *(Arena**)mem;
+    if (arena) arena->Free(mem, HEADER_SIZE + size);
+    else ::operator delete(mem);
+}
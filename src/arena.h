@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Bump allocator that hands out memory from big chunks and frees all of it at once when destroyed.
+// Each AST owns one, so its nodes and types are packed together in memory. Their destructors still run one by one, since nodes own memory outside the arena, like the lists of blocks and calls, but their own memory is only given back with the arena.
+class Arena
+{
+
+    // Memory chunks. They never move, so allocations stay valid until the arena is destroyed.
+    std::vector<std::unique_ptr<char[]>> chunks;
+
+    // Free space at the end of the current chunk.
+    char* pos = nullptr;
+    size_t left = 0;
+
+    // Arenas that are freed together with this one.
+    std::vector<std::unique_ptr<Arena>> children;
+
+public:
+
+    // Create an empty arena. No memory is reserved until the first allocation.
+    Arena() = default;
+
+    // Allocations point into the arena, so it can't be copied or moved.
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Allocate memory from the arena.
+    // size: Number of bytes to allocate.
+    // Returns: Memory aligned for any type.
+    void* Allocate(size_t size);
+
+    // Give back memory. It is only reused if it was the most recent allocation, as is the case for short-lived temporaries.
+    // ptr: Memory returned by Allocate.
+    // size: Size that was passed to Allocate.
+    void Free(void* ptr, size_t size);
+
+    // Create an arena that is freed together with this one. Useful to allocate for the same owner from multiple threads, since an arena itself is not thread safe.
+    // Returns: The new arena.
+    Arena& AddChild();
+
+    // Get the arena that allocations on the current thread go to.
+    // Returns: The current arena, or null if allocations go to the heap.
+    static Arena* Current();
+
+    // Set the arena that allocations on the current thread go to.
+    // arena: New current arena. Null to allocate from the heap.
+    static void SetCurrent(Arena* arena);
+
+};
+
+// Makes an arena the current one for as long as this is in scope.
+class ArenaScope
+{
+
+    // Arena that was current before.
+    Arena* previous;
+
+public:
+
+    // Make an arena the current one.
+    // arena: Arena to use.
+    explicit ArenaScope(Arena& arena) : previous(Arena::Current()) { Arena::SetCurrent(&arena); }
+
+    // Restoring twice would be wrong, so scopes can't be copied.
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    // Restore the previous arena.
+    ~ArenaScope() { Arena::SetCurrent(previous); }
+
+};
+
+// Base for types that should be allocated from the current arena.
+// Objects created with no current arena go to the heap instead, so this is safe to use outside of an AST.
+class ArenaAllocated
+{
+public:
+
+    // Allocate from the current arena if any, else from the heap.
+    static void* operator new(size_t size);
+
+    // Free memory. Arena memory is only reclaimed for temporaries, the rest goes away with the arena.
+    static void operator delete(void* ptr, size_t size);
+
+};
@@ -1,18 +1,28 @@
 #pragma once
 
+#include "arena.h"
 #include "function.h"
 #include "expression.h"
 #include "scopeTable.h"
+#include "symbol.h"
+#include "typeContext.h"
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
+#include <llvm/Support/raw_ostream.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
 // Abstract Syntax Tree, is the main representation of our program.
 class AST
 {
 
-    // Main LLVM context. Note: If we want support for multiple compilation units, this should be moved elsewhere.
+    // Arena that all nodes and types of this AST are allocated from. It is declared first so it is freed last, after everything in it.
+    Arena arena;
+
+    // LLVM context of this compilation unit. Each AST has its own so units can be compiled on separate threads, see the driver for linking them.
     llvm::LLVMContext context;
 
     // Module containing all functions.
@@ -22,10 +32,13 @@ class AST
     llvm::IRBuilder<> builder;
 
     // List of functions to be compiled in order.
-    std::vector<std::string> functionList;
+    std::vector<Symbol> functionList;
 
     // Map function names to values.
-    std::map<std::string, std::unique_ptr<ASTFunction>> functions;
+    std::unordered_map<Symbol, std::unique_ptr<ASTFunction>> functions;
+
+    // If the functions have been through semantic analysis or not.
+    bool analyzed = false;
 
     // If the module has been compiled or not.
     bool compiled = false;
@@ -35,9 +48,22 @@ public:
     // Function pass manager for function optimizations.
     llvm::legacy::FunctionPassManager fpm;
 
+    // Function types of this AST. Each one is made once, see TypeContext.
+    TypeContext types;
+
     // Scope table for variables and functions.
     ScopeTable scopeTable;
 
+    // Errors, warnings, and info messages from parsing and compiling, in the order they came up.
+    std::string diagnostics;
+
+    // Make allocations on the current thread go to this AST's arena while the returned scope is alive.
+    // Use this around any code that creates nodes or types for this AST.
+    ArenaScope UseArena() { return ArenaScope(arena); }
+
+    // Get the arena this AST's nodes are allocated from.
+    Arena& GetArena() { return arena; }
+
     // Create a new abstract syntax tree.
     // modName: Name of the module to create.
     AST(std::string modName);
@@ -48,18 +74,35 @@ public:
     // parameters: Collection of variable types and names to pass to the function call.
     // variadic: If the function is a variadic function.
     // Returns: A pointer to the newly added function.
-    ASTFunction* AddFunction(const std::string& name, std::unique_ptr<VarType> returnType, ASTFunctionParameters parameters, bool variadic = false);
+    ASTFunction* AddFunction(Symbol name, const VarType* returnType, ASTFunctionParameters parameters, bool variadic = false);
 
     // Get a function from a name.
     // name: Name of the function to fetch.
     // Returns: A pointer to the function. Throws an exception if it does not exist.
-    ASTFunction* GetFunction(const std::string& name);
+    ASTFunction* GetFunction(Symbol name);
 
-    // Compile the AST. This must be done before exporting any object files.
+    // Compile the AST. This must be done before exporting any object files, and after semantic analysis. Compiling does not change any nodes.
     void Compile();
 
-    // Get a string representation of the AST.
-    std::string ToString();
+    // Print the AST as a tree.
+    // out: Stream to print to.
+    void Print(std::ostream& out);
+
+    // Write LLVM assembly to a stream. Must be done after compilation.
+    // out: Stream to write to.
+    void WriteLLVMAssembly(llvm::raw_ostream& out);
+
+    // Write LLVM bitcode to a stream. Must be done after compilation.
+    // out: Stream to write to.
+    void WriteLLVMBitcode(llvm::raw_ostream& out);
+
+    // Write the AST in the binary AST format, see binaryAst.h. This should be done before optimizing or compiling, so the AST is as the front end made it.
+    // out: Stream to write to.
+    void WriteBinary(llvm::raw_ostream& out);
+
+    // Read functions into the AST from the binary AST format instead of parsing them, see binaryAst.h. Throws an exception if the data is malformed.
+    // data: Binary AST to read. It is only read from while this runs, so it can be a memory-mapped file.
+    void ReadBinary(std::string_view data);
 
     // Write LLVM assembly (.ll) to file. Must be done after compilation.
     // outFile: Where to write the .ll file.
@@ -69,33 +112,14 @@ public:
     // outFile: Where to write the .bc file.
     void WriteLLVMBitcodeToFile(const std::string& outFile);
 
-    // Perform dead code elimination on AST.
-    void DeadCodeEliminationPass();
-
-private:
+    // Write LLVM bitcode to a memory buffer. Must be done after compilation.
+    // buffer: Buffer to append the bitcode to.
+    void WriteLLVMBitcodeToBuffer(llvm::SmallVectorImpl<char>& buffer);
 
-    // Perform dead code elimination from designated node.
-    // node: Pointer to starting node.
-    // variables: Pointer to variable live status map.
-    // functions: Pointer to function live status map.
-    // eliminate: Whether to eliminate dead variables or just update live status
-    bool EliminateDeadCode(ASTStatement* node, std::map<std::string, bool>& variables, std::map<std::string, bool>& functions, bool eliminate);
-
-    // Remove an assignment statement
-    // node: Node of assignment to remove
-    void EliminateAssignmentStmt(std::unique_ptr<ASTStatement>& node);
-
-    // Perform unreachable code elimination at designated control-flow node.
-    // node: Pointer to node.
-    void EliminateUnreachableCode(ASTStatement* node);
-
-    // Evaluate a condition to identify always-true and always-false conditions
-    // condition: Pointer to condition to evaluate
-    int EvaluateExpression(ASTExpression* condition);
+    // Perform dead code elimination on AST. Constants are folded and propagated through variables, and comparisons are decided from the ranges of variables first, which prunes the branches and loops they decide, see ConstantFolder, ConstantPropagator, and RangeAnalyzer.
+    void DeadCodeEliminationPass();
 
-    // Merge second map into first, taking map1.bool = map1.bool || map2.bool for duplicate keys
-    // map1: Map to be merged into
-    // map2: Map to merge
-    void mergeVarMaps(std::map<std::string, bool>& map1, std::map<std::string, bool>& map2);
+    // Type check every function, adding implicit casts where needed. This must be done after any passes that change the AST and before compiling.
+    void SemanticAnalysisPass();
 
 };
\ No newline at end of file
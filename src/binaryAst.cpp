@@ -0,0 +1,220 @@
+#include "binaryAst.h"
+
+#include "ast.h"
+#include "flatAst.h"
+#include "types/simple.h"
+#include <cstring>
+#include <stdexcept>
+
+// Simple types by their VarTypeSimpleEnumeration, which is how types are stored.
+static const VarType* const SIMPLE_TYPES[] = { &VarTypeSimple::VoidType, &VarTypeSimple::BoolType, &VarTypeSimple::IntType, &VarTypeSimple::FloatType, &VarTypeSimple::StringType };
+
+// Get how a type is stored.
+// type: Type to store. Only simple types can be.
+// Returns: The VarTypeSimpleEnumeration of the type.
+static uint32_t EncodeType(const VarType* type)
+{
+    for (uint32_t i = 0; i < sizeof(SIMPLE_TYPES) / sizeof(SIMPLE_TYPES[0]); i++)
+    {
+        if (SIMPLE_TYPES[i] == type) return i;
+    }
+    throw std::runtime_error("ERROR: Only simple types can be written to a binary AST!");
+}
+
+// Get a type from how it is stored.
+// type: The VarTypeSimpleEnumeration of the type.
+// Returns: The simple type.
+static const VarType* DecodeType(uint32_t type)
+{
+    if (type >= sizeof(SIMPLE_TYPES) / sizeof(SIMPLE_TYPES[0])) throw std::runtime_error("ERROR: Unknown type in binary AST!");
+    return SIMPLE_TYPES[type];
+}
+
+// Append a section to a file being written.
+// file: File written so far, starting with space for the header.
+// header: Header to record the section in.
+// section: Which section it is.
+// items: Items of the section.
+template <typename T>
+static void AppendSection(std::string& file, BinaryASTHeader& header, BinaryASTSection section, const std::vector<T>& items)
+{
+    file.resize((file.size() + BINARY_AST_ALIGNMENT - 1) / BINARY_AST_ALIGNMENT * BINARY_AST_ALIGNMENT, '\0');
+    header.sections[(uint32_t)section] = { file.size(), items.size() };
+    file.append(reinterpret_cast<const char*>(items.data()), items.size() * sizeof(T));
+}
+
+// Get a section of a file being read, making sure it is in bounds.
+// data: Whole file.
+// header: Header of the file.
+// section: Which section to get.
+// Returns: The items of the section, which point into the file.
+template <typename T>
+static std::pair<const T*, size_t> GetSection(std::string_view data, const BinaryASTHeader& header, BinaryASTSection section)
+{
+    auto& entry = header.sections[(uint32_t)section];
+    if (entry.offset % alignof(T) != 0 || entry.offset > data.size() || entry.count > (data.size() - entry.offset) / sizeof(T))
+        throw std::runtime_error("ERROR: Binary AST section out of bounds!");
+    return { reinterpret_cast<const T*>(data.data() + entry.offset), (size_t)entry.count };
+}
+
+// Copy a section of a file being read into an array.
+// data: Whole file.
+// header: Header of the file.
+// section: Which section to copy.
+// items: Array to copy the items to.
+template <typename T>
+static void CopySection(std::string_view data, const BinaryASTHeader& header, BinaryASTSection section, std::vector<T>& items)
+{
+    auto [start, count] = GetSection<T>(data, header, section);
+    items.assign(start, start + count);
+}
+
+void AST::WriteBinary(llvm::raw_ostream& out)
+{
+
+    // Names are interned as they are first seen.
+    std::vector<BinaryASTString> names;
+    std::vector<BinaryASTString> strings;
+    std::string characters;
+    std::unordered_map<Symbol, uint32_t> nameIndices;
+    auto addString = [&](const std::string& str)
+    {
+        BinaryASTString ret = { (uint32_t)characters.size(), (uint32_t)str.size() };
+        characters += str;
+        return ret;
+    };
+    auto addName = [&](Symbol name)
+    {
+        auto found = nameIndices.find(name);
+        if (found != nameIndices.end()) return found->second;
+        names.push_back(addString(name.Name()));
+        return nameIndices[name] = (uint32_t)names.size() - 1;
+    };
+
+    // Gather every function, with all of their bodies going into one flat AST.
+    FlatAST flat;
+    std::vector<BinaryASTFunction> functionItems;
+    std::vector<BinaryASTVariable> variables;
+    for (auto& name : functionList)
+    {
+        auto& func = *functions[name];
+        BinaryASTFunction item;
+        item.name = addName(func.name);
+        item.returnType = EncodeType(func.funcType->returnType);
+        item.variadic = func.funcType->varArgs ? 1 : 0;
+
+        // Parameters are the first stack variables.
+        item.firstParameter = (uint32_t)variables.size();
+        item.parameterCount = (uint32_t)func.parameters.size();
+        for (size_t i = 0; i < func.parameters.size(); i++) variables.push_back({ addName(func.parameters[i]), EncodeType(func.funcType->parameterTypes[i]) });
+        item.firstStackVariable = (uint32_t)variables.size();
+        item.stackVariableCount = (uint32_t)(func.stackVariables.size() - func.parameters.size());
+        for (size_t i = func.parameters.size(); i < func.stackVariables.size(); i++) variables.push_back({ addName(func.stackVariables[i]), EncodeType(func.GetVariableType(func.stackVariables[i])) });
+
+        item.definition = flat.Flatten(func.definition.get());
+        functionItems.push_back(item);
+    }
+
+    // Nodes refer to names and strings by index.
+    std::vector<uint32_t> symbols;
+    for (auto& symbol : flat.symbols) symbols.push_back(addName(symbol));
+    for (auto& str : flat.strings) strings.push_back(addString(str));
+    std::vector<int32_t> ints(flat.ints.begin(), flat.ints.end());
+    static_assert(sizeof(ASTNodeKind) == sizeof(uint8_t), "Node kinds are stored as bytes.");
+
+    // Lay out the file, with the header going first once every section is placed.
+    BinaryASTHeader header = {};
+    memcpy(header.magic, BINARY_AST_MAGIC, sizeof(header.magic));
+    header.version = BINARY_AST_VERSION;
+    header.byteOrder = BINARY_AST_BYTE_ORDER;
+    header.sectionCount = (uint32_t)BinaryASTSection::Count;
+    std::string file(sizeof(header), '\0');
+    AppendSection(file, header, BinaryASTSection::Names, names);
+    AppendSection(file, header, BinaryASTSection::Strings, strings);
+    AppendSection(file, header, BinaryASTSection::Characters, std::vector<char>(characters.begin(), characters.end()));
+    AppendSection(file, header, BinaryASTSection::Functions, functionItems);
+    AppendSection(file, header, BinaryASTSection::Variables, variables);
+    AppendSection(file, header, BinaryASTSection::Kinds, flat.kinds);
+    AppendSection(file, header, BinaryASTSection::FirstChild, flat.firstChild);
+    AppendSection(file, header, BinaryASTSection::ChildCount, flat.childCount);
+    AppendSection(file, header, BinaryASTSection::Values, flat.values);
+    AppendSection(file, header, BinaryASTSection::Children, flat.children);
+    AppendSection(file, header, BinaryASTSection::Ints, ints);
+    AppendSection(file, header, BinaryASTSection::Floats, flat.floats);
+    AppendSection(file, header, BinaryASTSection::Symbols, symbols);
+    memcpy(file.data(), &header, sizeof(header));
+    out.write(file.data(), file.size());
+
+}
+
+void AST::ReadBinary(std::string_view data)
+{
+
+    // Make sure this is a file we can read.
+    BinaryASTHeader header;
+    if (data.size() < sizeof(header)) throw std::runtime_error("ERROR: Binary AST is too small!");
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, BINARY_AST_MAGIC, sizeof(header.magic)) != 0) throw std::runtime_error("ERROR: Input is not a binary AST!");
+    if (header.version != BINARY_AST_VERSION) throw std::runtime_error("ERROR: Binary AST is version " + std::to_string(header.version) + " but only version " + std::to_string(BINARY_AST_VERSION) + " is supported!");
+    if (header.byteOrder != BINARY_AST_BYTE_ORDER) throw std::runtime_error("ERROR: Binary AST was written on a machine of another byte order!");
+    if (header.sectionCount != (uint32_t)BinaryASTSection::Count) throw std::runtime_error("ERROR: Binary AST has the wrong number of sections!");
+
+    // Tables are used in place.
+    auto [names, nameCount] = GetSection<BinaryASTString>(data, header, BinaryASTSection::Names);
+    auto [strings, stringCount] = GetSection<BinaryASTString>(data, header, BinaryASTSection::Strings);
+    auto [characters, characterCount] = GetSection<char>(data, header, BinaryASTSection::Characters);
+    auto [functionItems, functionCount] = GetSection<BinaryASTFunction>(data, header, BinaryASTSection::Functions);
+    auto [variables, variableCount] = GetSection<BinaryASTVariable>(data, header, BinaryASTSection::Variables);
+    auto getString = [&](const BinaryASTString& str)
+    {
+        if (str.start > characterCount || str.size > characterCount - str.start) throw std::runtime_error("ERROR: Binary AST string out of bounds!");
+        return std::string_view(characters + str.start, str.size);
+    };
+    std::vector<Symbol> symbolTable;
+    symbolTable.reserve(nameCount);
+    for (size_t i = 0; i < nameCount; i++) symbolTable.emplace_back(getString(names[i]));
+    auto getName = [&](uint32_t name)
+    {
+        if (name >= symbolTable.size()) throw std::runtime_error("ERROR: Binary AST name out of bounds!");
+        return symbolTable[name];
+    };
+
+    // Node arrays are copied out in bulk, then checked before anything is built from them.
+    FlatAST flat;
+    std::vector<uint32_t> symbols;
+    std::vector<int32_t> ints;
+    CopySection(data, header, BinaryASTSection::Kinds, flat.kinds);
+    CopySection(data, header, BinaryASTSection::FirstChild, flat.firstChild);
+    CopySection(data, header, BinaryASTSection::ChildCount, flat.childCount);
+    CopySection(data, header, BinaryASTSection::Values, flat.values);
+    CopySection(data, header, BinaryASTSection::Children, flat.children);
+    CopySection(data, header, BinaryASTSection::Ints, ints);
+    CopySection(data, header, BinaryASTSection::Floats, flat.floats);
+    CopySection(data, header, BinaryASTSection::Symbols, symbols);
+    flat.ints.assign(ints.begin(), ints.end());
+    for (uint32_t symbol : symbols) flat.symbols.push_back(getName(symbol));
+    for (size_t i = 0; i < stringCount; i++) flat.strings.emplace_back(getString(strings[i]));
+    flat.types.assign(flat.Size(), nullptr); // Types are found again by type checking.
+    std::vector<FlatHandle> definitions;
+    for (size_t i = 0; i < functionCount; i++) definitions.push_back(functionItems[i].definition);
+    flat.Validate(definitions);
+
+    // Add the functions the same way the parser does.
+    auto scope = UseArena();
+    auto getVariables = [&](uint32_t first, uint32_t count)
+    {
+        if (first > variableCount || count > variableCount - first) throw std::runtime_error("ERROR: Binary AST variables out of bounds!");
+        ASTFunctionParameters ret;
+        for (uint32_t i = first; i < first + count; i++) ret.emplace_back(DecodeType(variables[i].type), getName(variables[i].name));
+        return ret;
+    };
+    for (size_t i = 0; i < functionCount; i++)
+    {
+        auto& item = functionItems[i];
+        auto f = AddFunction(getName(item.name), DecodeType(item.returnType), getVariables(item.firstParameter, item.parameterCount), item.variadic != 0);
+        if (item.definition == FLAT_NULL) continue; // Only a declaration. Definitions were range checked by Validate.
+        for (auto& var : getVariables(item.firstStackVariable, item.stackVariableCount)) f->AddStackVar(var);
+        f->Define(flat.Unflatten(item.definition));
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+    Binary AST files hold the AST of a single unit as the front end made it, so it can be compiled again without being parsed.
+    There are no pointers, everything is an array at an offset from the start of the file, so a file can be memory-mapped and its arrays read in place.
+    Function bodies are stored as the arrays of one FlatAST (see flatAst.h), with variables and strings referring to the name and string tables by index.
+    Numbers are stored in the byte order of the machine that wrote the file, which the header records so other machines can reject it.
+    See AST::WriteBinary and AST::ReadBinary for writing and reading these.
+*/
+
+// Identifies a binary AST file.
+constexpr char BINARY_AST_MAGIC[4] = { 'L', 'A', 'S', 'T' };
+
+// Version of the format. Bump this whenever the layout changes, so old files are rejected instead of misread.
+constexpr uint32_t BINARY_AST_VERSION = 1;
+
+// Written as is into the header. Reads back the same only on a machine of the same byte order.
+constexpr uint32_t BINARY_AST_BYTE_ORDER = 0x01020304;
+
+// Every section starts at a multiple of this from the start of the file.
+constexpr uint64_t BINARY_AST_ALIGNMENT = 8;
+
+// Sections of a file, in the order of the header's section table. What each section is an array of is noted.
+enum class BinaryASTSection : uint32_t
+{
+    Names, // BinaryASTString. Names of functions and variables.
+    Strings, // BinaryASTString. Values of string constants.
+    Characters, // char. Characters of every name and string.
+    Functions, // BinaryASTFunction. In the order they were declared.
+    Variables, // BinaryASTVariable. Parameters and stack variables of every function.
+    Kinds, // uint8_t. ASTNodeKind of each node.
+    FirstChild, // uint32_t. See FlatAST.
+    ChildCount, // uint32_t. See FlatAST.
+    Values, // uint32_t. See FlatAST.
+    Children, // uint32_t. See FlatAST.
+    Ints, // int32_t. Values of int constants.
+    Floats, // double. Values of float constants.
+    Symbols, // uint32_t. Index into the names of each variable node's name.
+    Count
+};
+
+// Where a section is.
+struct BinaryASTSectionEntry
+{
+
+    // Offset from the start of the file.
+    uint64_t offset;
+
+    // Number of items in the section.
+    uint64_t count;
+
+};
+
+// Start of every file.
+struct BinaryASTHeader
+{
+
+    // Always BINARY_AST_MAGIC.
+    char magic[4];
+
+    // Version of the format the file is in.
+    uint32_t version;
+
+    // BINARY_AST_BYTE_ORDER in the byte order of the writer.
+    uint32_t byteOrder;
+
+    // Number of sections, always BinaryASTSection::Count.
+    uint32_t sectionCount;
+
+    // Where each section is.
+    BinaryASTSectionEntry sections[(uint32_t)BinaryASTSection::Count];
+
+};
+
+// A range of the characters section.
+struct BinaryASTString
+{
+
+    // Index of the first character.
+    uint32_t start;
+
+    // Number of characters.
+    uint32_t size;
+
+};
+
+// A parameter or stack variable.
+struct BinaryASTVariable
+{
+
+    // Index into the names.
+    uint32_t name;
+
+    // Type of the variable, a VarTypeSimpleEnumeration.
+    uint32_t type;
+
+};
+
+// A function declaration, and its definition if it has one.
+struct BinaryASTFunction
+{
+
+    // Index into the names.
+    uint32_t name;
+
+    // Type the function returns, a VarTypeSimpleEnumeration.
+    uint32_t returnType;
+
+    // 1 if the function takes variadic arguments, 0 if not.
+    uint32_t variadic;
+
+    // Range of variables that are the parameters.
+    uint32_t firstParameter;
+    uint32_t parameterCount;
+
+    // Range of variables that are the stack variables.
+    uint32_t firstStackVariable;
+    uint32_t stackVariableCount;
+
+    // Node that is the body of the function, or FLAT_NULL if it is only declared.
+    uint32_t definition;
+
+};
\ No newline at end of file
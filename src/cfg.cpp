@@ -0,0 +1,321 @@
+#include "cfg.h"
+
+#include "function.h"
+#include "statements/block.h"
+#include "statements/for.h"
+#include "statements/if.h"
+#include "statements/return.h"
+#include "statements/while.h"
+#include "expressions/assignment.h"
+#include "expressions/binary.h"
+#include "expressions/bool2Int.h"
+#include "expressions/call.h"
+#include "expressions/float2Int.h"
+#include "expressions/int2Bool.h"
+#include "expressions/int2Float.h"
+#include "expressions/negative.h"
+#include "expressions/variable.h"
+
+CFG::CFG(ASTFunction& function) : variables(function.stackVariables), parameterCount((uint32_t)function.parameters.size())
+{
+
+    // Parameters are among the stack variables, so this numbers every variable.
+    for (uint32_t i = 0; i < variables.size(); i++) indices.emplace(variables[i], i);
+
+    // The body runs from the entry, and falls off its end into the exit.
+    NewBlock();
+    NewBlock();
+    StartBlock(ENTRY);
+    Lower(function.definition.get());
+    AddEdge(current, EXIT);
+    StartBlock(EXIT);
+
+}
+
+uint32_t CFG::VariableIndex(Symbol var) const
+{
+    auto found = indices.find(var);
+    return found == indices.end() ? UINT32_MAX : found->second;
+}
+
+std::vector<CFGBlockId> CFG::ReversePostorder() const
+{
+
+    // Depth first search with an explicit stack of blocks and how many of their successors have been followed.
+    std::vector<CFGBlockId> order;
+    std::vector<bool> visited(blocks.size(), false);
+    std::vector<std::pair<CFGBlockId, size_t>> stack = { { ENTRY, 0 } };
+    visited[ENTRY] = true;
+    while (!stack.empty())
+    {
+        auto& [block, next] = stack.back();
+        if (next < blocks[block].successors.size())
+        {
+            CFGBlockId successor = blocks[block].successors[next++];
+            if (!visited[successor])
+            {
+                visited[successor] = true;
+                stack.push_back({ successor, 0 });
+            }
+        }
+        else
+        {
+            order.push_back(block);
+            stack.pop_back();
+        }
+    }
+    return std::vector<CFGBlockId>(order.rbegin(), order.rend());
+
+}
+
+CFGBlockId CFG::NewBlock()
+{
+    blocks.emplace_back();
+    return (CFGBlockId)blocks.size() - 1;
+}
+
+void CFG::StartBlock(CFGBlockId block)
+{
+    current = block;
+    blocks[block].firstAccess = (uint32_t)accesses.size();
+}
+
+void CFG::AddEdge(CFGBlockId from, CFGBlockId to)
+{
+    blocks[from].successors.push_back(to);
+    blocks[to].predecessors.push_back(from);
+}
+
+void CFG::AddAccess(CFGAccessKind kind, Symbol var, ASTExpression* node, std::unique_ptr<ASTExpression>* slot)
+{
+    uint32_t index = VariableIndex(var);
+    if (index == UINT32_MAX) return; // Function names are not variables.
+    accesses.push_back({ kind, index, node, slot });
+    blocks[current].accessCount++;
+}
+
+void CFG::EndBlock(ASTStatement* branch, ASTExpression* condition, CFGBlockId ifTrue, CFGBlockId ifFalse)
+{
+    blocks[current].branch = branch;
+    blocks[current].condition = condition;
+    AddEdge(current, ifTrue);
+    if (condition) AddEdge(current, ifFalse);
+}
+
+void CFG::Lower(ASTStatement* node)
+{
+    work.push_back({ LowerAction::Statement, node });
+    while (!work.empty())
+    {
+        LowerStep step = work.back();
+        work.pop_back();
+
+        // The steps a step queues go on the stack backwards so the first pops first.
+        RunStep(step);
+        work.insert(work.end(), steps.rbegin(), steps.rend());
+        steps.clear();
+    }
+}
+
+void CFG::RunStep(const LowerStep& step)
+{
+    switch (step.action)
+    {
+
+        case LowerAction::Statement:
+            LowerStatement(step.node);
+            break;
+
+        case LowerAction::Expression:
+            LowerExpression(static_cast<ASTExpression*>(step.node), step.slot);
+            break;
+
+        case LowerAction::Def:
+            AddAccess(CFGAccessKind::Def, static_cast<ASTExpressionVariable*>(static_cast<ASTExpressionAssignment*>(step.node)->left.get())->var, static_cast<ASTExpression*>(step.node), step.slot);
+            break;
+
+        // The branches each get a block, and both go on to the code after the if.
+        case LowerAction::IfBranch:
+        {
+            auto ifNode = static_cast<ASTStatementIf*>(step.node);
+            CFGBlockId thenBlock = NewBlock();
+            CFGBlockId elseBlock = NewBlock();
+            CFGBlockId after = NewBlock();
+            EndBlock(ifNode, ifNode->condition.get(), thenBlock, elseBlock);
+            StartBlock(thenBlock);
+            steps.push_back({ LowerAction::Statement, ifNode->thenStatement.get() });
+            steps.push_back({ LowerAction::Join, ifNode, nullptr, after, elseBlock });
+            steps.push_back({ LowerAction::Statement, ifNode->elseStatement.get() });
+            steps.push_back({ LowerAction::Join, ifNode, nullptr, after, after });
+            break;
+        }
+
+        case LowerAction::Loop:
+            StartLoop(step.node);
+            break;
+
+        case LowerAction::LoopBranch:
+        {
+            ASTExpression* condition = step.node->kind == ASTNodeKind::While ? static_cast<ASTStatementWhile*>(step.node)->condition.get() : static_cast<ASTStatementFor*>(step.node)->condition.get();
+            EndBlock(step.node, condition, step.first, step.second);
+            StartBlock(step.first);
+            break;
+        }
+
+        // The right operand only runs if the left one does not decide the result, like with the code generator's blocks.
+        case LowerAction::ShortCircuit:
+        {
+            auto binary = static_cast<ASTExpressionBinary*>(step.node);
+            CFGBlockId right = NewBlock();
+            CFGBlockId after = NewBlock();
+            if (binary->kind == ASTNodeKind::And) EndBlock(binary, binary->a1.get(), right, after);
+            else EndBlock(binary, binary->a1.get(), after, right);
+            StartBlock(right);
+            steps.push_back({ LowerAction::Expression, binary->a2.get(), &binary->a2 });
+            steps.push_back({ LowerAction::Join, binary, nullptr, after, after });
+            break;
+        }
+
+        // Code after a return goes in a new block nothing goes to.
+        case LowerAction::Return:
+            blocks[current].branch = step.node;
+            AddEdge(current, EXIT);
+            StartBlock(NewBlock());
+            break;
+
+        case LowerAction::Join:
+            AddEdge(current, step.first);
+            StartBlock(step.second);
+            break;
+
+    }
+}
+
+void CFG::LowerStatement(ASTStatement* node)
+{
+    if (!node) return;
+    if (node->IsExpression()) return LowerExpression(static_cast<ASTExpression*>(node), nullptr);
+    switch (node->kind)
+    {
+
+        case ASTNodeKind::Block:
+            for (auto& statement : static_cast<ASTStatementBlock*>(node)->statements) steps.push_back({ LowerAction::Statement, statement.get() });
+            break;
+
+        case ASTNodeKind::If:
+        {
+            auto ifNode = static_cast<ASTStatementIf*>(node);
+            steps.push_back({ LowerAction::Expression, ifNode->condition.get(), &ifNode->condition });
+            steps.push_back({ LowerAction::IfBranch, ifNode });
+            break;
+        }
+
+        case ASTNodeKind::While:
+            StartLoop(node);
+            break;
+
+        // The init runs once before the head.
+        case ASTNodeKind::For:
+            steps.push_back({ LowerAction::Statement, static_cast<ASTStatementFor*>(node)->init.get() });
+            steps.push_back({ LowerAction::Loop, node });
+            break;
+
+        case ASTNodeKind::Return:
+        {
+            auto returnNode = static_cast<ASTStatementReturn*>(node);
+            if (returnNode->returnExpression) steps.push_back({ LowerAction::Expression, returnNode->returnExpression.get(), &returnNode->returnExpression });
+            steps.push_back({ LowerAction::Return, returnNode });
+            break;
+        }
+
+        default:
+            break;
+
+    }
+}
+
+void CFG::StartLoop(ASTStatement* node)
+{
+
+    // The head checks the condition before every iteration, and the end of the body goes back to it. A for loop runs its increment at the end of the body.
+    CFGBlockId head = NewBlock();
+    CFGBlockId body = NewBlock();
+    CFGBlockId after = NewBlock();
+    AddEdge(current, head);
+    StartBlock(head);
+    blocks[head].loop = node;
+    if (node->kind == ASTNodeKind::While)
+    {
+        auto whileNode = static_cast<ASTStatementWhile*>(node);
+        steps.push_back({ LowerAction::Expression, whileNode->condition.get(), &whileNode->condition });
+        steps.push_back({ LowerAction::LoopBranch, node, nullptr, body, after });
+        steps.push_back({ LowerAction::Statement, whileNode->thenStatement.get() });
+    }
+    else
+    {
+        auto forNode = static_cast<ASTStatementFor*>(node);
+        if (forNode->condition) steps.push_back({ LowerAction::Expression, forNode->condition.get(), &forNode->condition });
+        steps.push_back({ LowerAction::LoopBranch, node, nullptr, body, after });
+        steps.push_back({ LowerAction::Statement, forNode->body.get() });
+        steps.push_back({ LowerAction::Statement, forNode->increment.get() });
+    }
+    steps.push_back({ LowerAction::Join, node, nullptr, head, after });
+
+}
+
+void CFG::LowerExpression(ASTExpression* node, std::unique_ptr<ASTExpression>* slot)
+{
+
+    // Operands are queued as their own steps, for one operand this is its node and where the parent holds it.
+    auto operand = [&](std::unique_ptr<ASTExpression>& child)
+    {
+        steps.push_back({ LowerAction::Expression, child.get(), &child });
+    };
+    switch (node->kind)
+    {
+
+        case ASTNodeKind::Variable:
+            AddAccess(CFGAccessKind::Use, static_cast<ASTExpressionVariable*>(node)->var, node, slot);
+            break;
+
+        // The value is found before the variable is written.
+        case ASTNodeKind::Assignment:
+            operand(static_cast<ASTExpressionAssignment*>(node)->right);
+            steps.push_back({ LowerAction::Def, node, slot });
+            break;
+
+        case ASTNodeKind::Call:
+        {
+            auto call = static_cast<ASTExpressionCall*>(node);
+            operand(call->callee);
+            for (auto& argument : call->arguments) operand(argument);
+            break;
+        }
+
+        case ASTNodeKind::And:
+        case ASTNodeKind::Or:
+            operand(static_cast<ASTExpressionBinary*>(node)->a1);
+            steps.push_back({ LowerAction::ShortCircuit, node });
+            break;
+
+        case ASTNodeKind::Addition:
+        case ASTNodeKind::Subtraction:
+        case ASTNodeKind::Multiplication:
+        case ASTNodeKind::Division:
+        case ASTNodeKind::Comparison:
+            operand(static_cast<ASTExpressionBinary*>(node)->a1);
+            operand(static_cast<ASTExpressionBinary*>(node)->a2);
+            break;
+
+        case ASTNodeKind::Negation: operand(static_cast<ASTExpressionNegation*>(node)->operand); break;
+        case ASTNodeKind::Int2Float: operand(static_cast<ASTExpressionInt2Float*>(node)->operand); break;
+        case ASTNodeKind::Float2Int: operand(static_cast<ASTExpressionFloat2Int*>(node)->operand); break;
+        case ASTNodeKind::Int2Bool: operand(static_cast<ASTExpressionInt2Bool*>(node)->operand); break;
+        case ASTNodeKind::Bool2Int: operand(static_cast<ASTExpressionBool2Int*>(node)->operand); break;
+
+        // Constants touch no variables.
+        default:
+            break;
+
+    }
+}
\ No newline at end of file
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "expression.h"
+#include "symbol.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations.
+class ASTFunction;
+
+// Index of a basic block in a CFG.
+typedef uint32_t CFGBlockId;
+
+// A missing block, like the immediate dominator of the entry.
+constexpr CFGBlockId CFG_NONE = UINT32_MAX;
+
+// How an access touches its variable.
+enum class CFGAccessKind : uint8_t
+{
+    Use, // The variable is read.
+    Def // The variable is assigned.
+};
+
+// A read or write of a variable.
+struct CFGAccess
+{
+
+    // Whether the variable is read or assigned.
+    CFGAccessKind kind;
+
+    // Number of the variable, see CFG::variables.
+    uint32_t var;
+
+    // The variable node read for a use, or the assignment for a def.
+    ASTExpression* node;
+
+    // Where the node is held in the tree, so a rewrite can replace it. Null if it is held as a statement of its own.
+    std::unique_ptr<ASTExpression>* slot;
+
+};
+
+// Code that always runs from start to end, with control only entering at the start and leaving at the end.
+struct CFGBlock
+{
+
+    // Range of the CFG's accesses that happen in this block, in the order they happen.
+    uint32_t firstAccess = 0;
+    uint32_t accessCount = 0;
+
+    // Blocks control can go to next. When the block ends in a condition, the first is taken if it is true and the second if it is false.
+    std::vector<CFGBlockId> successors;
+
+    // Blocks control can come from, once for every edge from them.
+    std::vector<CFGBlockId> predecessors;
+
+    // Node whose control flow ends the block: the if, loop, && or || it branches for, or the return it leaves through. Null if it just falls through.
+    ASTStatement* branch = nullptr;
+
+    // Loop node whose iterations start in this block, which is where its condition starts. Null if the block does not start an iteration.
+    ASTStatement* loop = nullptr;
+
+    // Condition the block ends by checking, which is evaluated last in it. Null if the block ends unconditionally.
+    // For && and || this is the left operand, which decides if the right one runs.
+    ASTExpression* condition = nullptr;
+
+};
+
+// Control flow graph of a function body, lowered from its AST so analyses can run over basic blocks instead of walking the tree.
+// Blocks refer back to the nodes they came from, so rewrites found on the graph land in the tree. The graph points into the body, so it is only valid until the body changes.
+// && and || get blocks of their own, since their right operand only runs sometimes. Every return and the end of the body go to the exit block.
+class CFG
+{
+
+    // What a step of lowering does.
+    enum class LowerAction
+    {
+        Statement, // Lower a statement. May be null.
+        Expression, // Lower an expression held in slot, or held as a statement of its own if slot is null.
+        Def, // Add the def of an assignment held in slot, once its value is lowered.
+        IfBranch, // End the block of an if's condition, once it is lowered, and start the then branch.
+        Loop, // Start the head of a loop, once the init of a for loop is lowered.
+        LoopBranch, // End the head of a loop, once its condition is lowered, going to first if it is true and second if not. Then start first.
+        ShortCircuit, // End the block of the left operand of an && or ||, once it is lowered, and start the right one.
+        Return, // Leave through a return, once its value is lowered.
+        Join // Go from the current block to first, then start second.
+    };
+
+    // A step of lowering waiting to run.
+    struct LowerStep
+    {
+
+        // What the step does.
+        LowerAction action;
+
+        // Node the step is for.
+        ASTStatement* node;
+
+        // Where an expression is held, see LowerAction.
+        std::unique_ptr<ASTExpression>* slot = nullptr;
+
+        // Blocks the step goes to, see LowerAction.
+        CFGBlockId first = CFG_NONE;
+        CFGBlockId second = CFG_NONE;
+
+    };
+
+    // Number of each variable by name.
+    std::unordered_map<Symbol, uint32_t> indices;
+
+    // Block code is being added to while lowering.
+    CFGBlockId current = ENTRY;
+
+    // Steps left to run, with the next one at the back. Bodies are lowered with this instead of recursion, so nesting is only limited by memory.
+    std::vector<LowerStep> work;
+
+    // Steps queued by the step being run, in the order they run.
+    std::vector<LowerStep> steps;
+
+    // Add an empty block.
+    // Returns: The new block.
+    CFGBlockId NewBlock();
+
+    // Make a block the one code is added to. Every block is started once, so its accesses are contiguous.
+    // block: Block to start.
+    void StartBlock(CFGBlockId block);
+
+    // Add an edge between two blocks.
+    // from: Block control leaves.
+    // to: Block control goes to.
+    void AddEdge(CFGBlockId from, CFGBlockId to);
+
+    // Add an access to the current block.
+    // kind: Whether the variable is read or assigned.
+    // var: Name of the variable. Names that are not variables of the function are skipped.
+    // node: The variable node read for a use, or the assignment for a def.
+    // slot: Where the node is held, or null if it is a statement of its own.
+    void AddAccess(CFGAccessKind kind, Symbol var, ASTExpression* node, std::unique_ptr<ASTExpression>* slot);
+
+    // End the current block with a condition.
+    // branch: Node that branches.
+    // condition: Condition checked. May be null to always go to ifTrue.
+    // ifTrue: Block to go to if the condition is true.
+    // ifFalse: Block to go to if it is false.
+    void EndBlock(ASTStatement* branch, ASTExpression* condition, CFGBlockId ifTrue, CFGBlockId ifFalse);
+
+    // Lower a statement and everything below it into the current block and the blocks after it.
+    // node: Statement to lower. May be null.
+    void Lower(ASTStatement* node);
+
+    // Run a step of lowering, queueing the steps that come after it.
+    // step: Step to run.
+    void RunStep(const LowerStep& step);
+
+    // Queue the steps that lower a statement.
+    // node: Statement to lower. May be null.
+    void LowerStatement(ASTStatement* node);
+
+    // Queue the steps that lower an expression.
+    // node: Expression to lower.
+    // slot: Where the expression is held, or null if it is a statement of its own.
+    void LowerExpression(ASTExpression* node, std::unique_ptr<ASTExpression>* slot);
+
+    // Start the head of a loop and queue the steps that lower its condition, body and increment.
+    // node: While or for loop to start.
+    void StartLoop(ASTStatement* node);
+
+public:
+
+    // The block control starts in, which no block goes to.
+    static constexpr CFGBlockId ENTRY = 0;
+
+    // The block every return goes to. It has no accesses and no successors.
+    static constexpr CFGBlockId EXIT = 1;
+
+    // Every block. Blocks after unreachable code like a return have no predecessors.
+    std::vector<CFGBlock> blocks;
+
+    // Accesses of every block, as ranges given by firstAccess and accessCount.
+    std::vector<CFGAccess> accesses;
+
+    // Name of each variable by number. The parameters come first, in order.
+    std::vector<Symbol> variables;
+
+    // Number of parameters among the variables.
+    uint32_t parameterCount;
+
+    // Lower the body of a function.
+    // function: Function to lower. It must be defined.
+    explicit CFG(ASTFunction& function);
+
+    // Get the number of a variable.
+    // var: Name of the variable.
+    // Returns: Its number, or UINT32_MAX if the function has no such variable.
+    uint32_t VariableIndex(Symbol var) const;
+
+    // Get the blocks that can be reached from the entry in reverse postorder, where every block comes before its successors other than along loop back edges.
+    // Returns: The blocks in order.
+    std::vector<CFGBlockId> ReversePostorder() const;
+
+};
\ No newline at end of file
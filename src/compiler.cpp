@@ -0,0 +1,67 @@
+#include "compiler.h"
+
+#include "driver.h"
+#include <sstream>
+#include <stdexcept>
+
+// Run a driver with its units added and gather the results.
+// driver: Driver to run.
+// options: Options of the compilation.
+// Returns: The compiled output and diagnostics.
+static CompileResult RunDriver(Driver& driver, const CompileOptions& options)
+{
+    CompileResult result;
+    try
+    {
+        result.success = driver.Run();
+        result.diagnostics = driver.Diagnostics();
+        if (!result.success) return result;
+
+        // Dump the AST of every unit.
+        std::ostringstream astOut;
+        if (options.printAst || options.format == CompileFormat::Ast)
+        {
+            for (auto& unit : driver.Units())
+            {
+                unit.context->ast.Print(astOut);
+                astOut << "\n";
+            }
+        }
+        std::string ast = astOut.str();
+        if (options.printAst) result.ast = ast;
+
+        // Produce the output.
+        llvm::raw_string_ostream out(result.output);
+        if (options.format == CompileFormat::Assembly) driver.WriteLLVMAssembly(out);
+        else if (options.format == CompileFormat::Bitcode) driver.WriteLLVMBitcode(out);
+        else if (options.format == CompileFormat::Ast) out << ast;
+        else if (options.format == CompileFormat::AstBinary)
+        {
+            if (driver.Units().size() != 1) throw std::runtime_error("ERROR: Binary AST output needs exactly one input!");
+            driver.Units()[0].context->ast.WriteBinary(out);
+        }
+        out.flush();
+    }
+    catch (const std::exception& e)
+    {
+        result.success = false;
+        result.diagnostics += std::string(e.what()) + "\n";
+    }
+    return result;
+}
+
+CompileResult CompileSource(std::string_view source, const CompileOptions& options)
+{
+    Driver driver(options.threads, options.format == CompileFormat::AstBinary);
+    driver.AddSource("", source);
+    return RunDriver(driver, options);
+}
+
+CompileResult CompileFiles(const std::vector<std::string>& inputFiles, const CompileOptions& options, const std::vector<std::string>& binaryAstFiles)
+{
+    Driver driver(options.threads, options.format == CompileFormat::AstBinary); // A binary AST is written as parsed.
+    if (inputFiles.empty() && binaryAstFiles.empty()) driver.AddFile(""); // Standard in.
+    for (auto& file : inputFiles) driver.AddFile(file);
+    for (auto& file : binaryAstFiles) driver.AddBinaryAstFile(file);
+    return RunDriver(driver, options);
+}
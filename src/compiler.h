@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Entry point for using the compiler as a library. Everything happens in memory: no files are written and no process is spawned.
+// Compilations share no state, so many can run at once on different threads.
+
+// What a compilation outputs.
+enum class CompileFormat
+{
+    Assembly, // LLVM assembly (.ll).
+    Bitcode, // LLVM bitcode (.bc).
+    Ast, // The abstract syntax tree as text.
+    AstBinary, // The abstract syntax tree in the binary AST format, see binaryAst.h. Only a single input can be output this way.
+    None // Nothing, only compile.
+};
+
+// Options that control a compilation.
+struct CompileOptions
+{
+
+    // What to output.
+    CompileFormat format = CompileFormat::Assembly;
+
+    // If to also dump the AST of every input to the result, no matter the format.
+    bool printAst = false;
+
+    // Number of worker threads. 0 uses one per hardware thread.
+    unsigned threads = 1;
+
+};
+
+// Everything a compilation produces.
+struct CompileResult
+{
+
+    // If compilation succeeded. If not, the diagnostics tell why.
+    bool success = false;
+
+    // Output in the requested format. Empty if compilation failed.
+    std::string output;
+
+    // AST of every input in input order, if asked for.
+    std::string ast;
+
+    // Errors, warnings, and info messages.
+    std::string diagnostics;
+
+};
+
+// Compile source held in memory.
+// source: Source code to compile.
+// options: Options of the compilation.
+// Returns: The compiled output and diagnostics.
+CompileResult CompileSource(std::string_view source, const CompileOptions& options = CompileOptions());
+
+// Compile files and link them together.
+// inputFiles: Files to compile. If there are no files at all, standard in is compiled instead.
+// options: Options of the compilation.
+// binaryAstFiles: Binary AST files to compile, which skip parsing. They come after the input files.
+// Returns: The compiled output and diagnostics.
+CompileResult CompileFiles(const std::vector<std::string>& inputFiles, const CompileOptions& options = CompileOptions(), const std::vector<std::string>& binaryAstFiles = {});
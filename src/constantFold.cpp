@@ -0,0 +1,381 @@
+#include "constantFold.h"
+
+#include "function.h"
+#include "statements/block.h"
+#include "statements/for.h"
+#include "statements/if.h"
+#include "statements/return.h"
+#include "statements/while.h"
+#include "expressions/arithmetic.h"
+#include "expressions/assignment.h"
+#include "expressions/bool2Int.h"
+#include "expressions/bool.h"
+#include "expressions/call.h"
+#include "expressions/comparison.h"
+#include "expressions/float.h"
+#include "expressions/float2Int.h"
+#include "expressions/int.h"
+#include "expressions/int2Bool.h"
+#include "expressions/int2Float.h"
+#include "expressions/negative.h"
+#include <algorithm>
+#include <cstring>
+
+// Fold an arithmetic operation the way its node compiles it: on ints if both operands are ints, and on doubles if either is a float.
+template <typename Traits>
+static ConstantValue FoldArithmetic(ConstantValue a, ConstantValue b)
+{
+    if (a.kind == ConstantValue::Kind::Int && b.kind == ConstantValue::Kind::Int)
+    {
+        if (!Traits::CanFold(a.intValue, b.intValue)) return ConstantValue();
+        return ConstantValue::Int(Traits::Fold(a.intValue, b.intValue));
+    }
+    a = ConstantFolder::EvaluateUnary(ASTNodeKind::Int2Float, a);
+    b = ConstantFolder::EvaluateUnary(ASTNodeKind::Int2Float, b);
+    if (a.kind != ConstantValue::Kind::Float || b.kind != ConstantValue::Kind::Float) return ConstantValue(); // Bools are not allowed in arithmetic.
+    return ConstantValue::Float(Traits::Fold(a.floatValue, b.floatValue));
+}
+
+// Compare two values of the same type like the LLVM comparisons do. Float comparisons are ordered, so they are all false if either operand is NaN.
+template <typename T>
+static bool Compare(ASTExpressionComparisonType type, T a, T b)
+{
+    switch (type)
+    {
+        case Equal: return a == b;
+        case NotEqual: return a < b || a > b;
+        case LessThan: return a < b;
+        case LessThanOrEqual: return a <= b;
+        case GreaterThan: return a > b;
+        case GreaterThanOrEqual: return a >= b;
+    }
+    return false;
+}
+
+static bool IsLiteral(const ASTStatement* node)
+{
+    return node->kind == ASTNodeKind::Int || node->kind == ASTNodeKind::Float || node->kind == ASTNodeKind::Bool;
+}
+
+ConstantValue ConstantValue::ToBool() const
+{
+    switch (kind)
+    {
+        case Kind::Bool: return *this;
+        case Kind::Int: return ConstantFolder::EvaluateUnary(ASTNodeKind::Int2Bool, *this);
+        case Kind::Float: return ConstantFolder::EvaluateUnary(ASTNodeKind::Int2Bool, ConstantFolder::EvaluateUnary(ASTNodeKind::Float2Int, *this));
+        default: return ConstantValue();
+    }
+}
+
+ConstantValue ConstantValue::ImplicitCast(const VarType* type) const
+{
+    if (type->Equals(&VarTypeSimple::BoolType)) return ToBool();
+    if (type->Equals(&VarTypeSimple::IntType))
+    {
+        if (kind == Kind::Bool) return ConstantFolder::EvaluateUnary(ASTNodeKind::Bool2Int, *this);
+        if (kind == Kind::Float) return ConstantFolder::EvaluateUnary(ASTNodeKind::Float2Int, *this);
+        return *this;
+    }
+    if (type->Equals(&VarTypeSimple::FloatType)) return ConstantFolder::EvaluateUnary(ASTNodeKind::Int2Float, ConstantFolder::EvaluateUnary(ASTNodeKind::Bool2Int, *this));
+    return ConstantValue();
+}
+
+bool ConstantValue::SameAs(const ConstantValue& other) const
+{
+    if (kind != other.kind) return false;
+    switch (kind)
+    {
+        case Kind::Int: return intValue == other.intValue;
+        case Kind::Float: return std::memcmp(&floatValue, &other.floatValue, sizeof(double)) == 0;
+        case Kind::Bool: return boolValue == other.boolValue;
+        default: return false;
+    }
+}
+
+std::unique_ptr<ASTExpression> ConstantValue::MakeLiteral() const
+{
+    switch (kind)
+    {
+        case Kind::Int: return ASTExpressionInt::Create(intValue);
+        case Kind::Float: return ASTExpressionFloat::Create(floatValue);
+        case Kind::Bool: return ASTExpressionBool::Create(boolValue);
+        default: throw std::runtime_error("ERROR: Can not make a literal of an unknown value!");
+    }
+}
+
+ConstantValue ConstantFolder::Evaluate(const ASTStatement* expr)
+{
+    if (!expr) return ConstantValue();
+    switch (expr->kind)
+    {
+
+        case ASTNodeKind::Int:
+            return ConstantValue::Int(static_cast<const ASTExpressionInt*>(expr)->value);
+
+        case ASTNodeKind::Float:
+            return ConstantValue::Float(static_cast<const ASTExpressionFloat*>(expr)->value);
+
+        case ASTNodeKind::Bool:
+            return ConstantValue::Bool(static_cast<const ASTExpressionBool*>(expr)->value);
+
+        // The right operand of && and || is only needed if the left one does not decide the result.
+        case ASTNodeKind::And:
+        case ASTNodeKind::Or:
+        {
+            auto binary = static_cast<const ASTExpressionBinary*>(expr);
+            ConstantValue left = Evaluate(binary->a1.get());
+            ConstantValue result = EvaluateBinary(*binary, left, ConstantValue());
+            return result.IsKnown() ? result : EvaluateBinary(*binary, left, Evaluate(binary->a2.get()));
+        }
+
+        case ASTNodeKind::Addition:
+        case ASTNodeKind::Subtraction:
+        case ASTNodeKind::Multiplication:
+        case ASTNodeKind::Division:
+        case ASTNodeKind::Comparison:
+        {
+            auto binary = static_cast<const ASTExpressionBinary*>(expr);
+            return EvaluateBinary(*binary, Evaluate(binary->a1.get()), Evaluate(binary->a2.get()));
+        }
+
+        case ASTNodeKind::Negation:
+            return EvaluateUnary(expr->kind, Evaluate(static_cast<const ASTExpressionNegation*>(expr)->operand.get()));
+
+        case ASTNodeKind::Int2Float:
+            return EvaluateUnary(expr->kind, Evaluate(static_cast<const ASTExpressionInt2Float*>(expr)->operand.get()));
+
+        case ASTNodeKind::Float2Int:
+            return EvaluateUnary(expr->kind, Evaluate(static_cast<const ASTExpressionFloat2Int*>(expr)->operand.get()));
+
+        case ASTNodeKind::Int2Bool:
+            return EvaluateUnary(expr->kind, Evaluate(static_cast<const ASTExpressionInt2Bool*>(expr)->operand.get()));
+
+        case ASTNodeKind::Bool2Int:
+            return EvaluateUnary(expr->kind, Evaluate(static_cast<const ASTExpressionBool2Int*>(expr)->operand.get()));
+
+        // Variables, calls, and assignments can't be known without looking at the code around them, and strings are never folded.
+        default:
+            return ConstantValue();
+
+    }
+}
+
+ConstantValue ConstantFolder::EvaluateBinary(const ASTExpressionBinary& node, ConstantValue a, ConstantValue b)
+{
+    switch (node.kind)
+    {
+
+        case ASTNodeKind::Addition: return FoldArithmetic<ASTAdditionTraits>(a, b);
+        case ASTNodeKind::Subtraction: return FoldArithmetic<ASTSubtractionTraits>(a, b);
+        case ASTNodeKind::Multiplication: return FoldArithmetic<ASTMultiplicationTraits>(a, b);
+        case ASTNodeKind::Division: return FoldArithmetic<ASTDivisionTraits>(a, b);
+
+        // Bools are compared as ints, and ints are compared as floats if the other operand is one.
+        case ASTNodeKind::Comparison:
+        {
+            auto type = static_cast<const ASTExpressionComparison&>(node).type;
+            a = EvaluateUnary(ASTNodeKind::Bool2Int, a);
+            b = EvaluateUnary(ASTNodeKind::Bool2Int, b);
+            if (a.kind == ConstantValue::Kind::Int && b.kind == ConstantValue::Kind::Int) return ConstantValue::Bool(Compare(type, a.intValue, b.intValue));
+            a = EvaluateUnary(ASTNodeKind::Int2Float, a);
+            b = EvaluateUnary(ASTNodeKind::Int2Float, b);
+            if (a.kind == ConstantValue::Kind::Float && b.kind == ConstantValue::Kind::Float) return ConstantValue::Bool(Compare(type, a.floatValue, b.floatValue));
+            return ConstantValue();
+        }
+
+        // A false left operand decides && and a true one decides ||. Otherwise the result is the right operand.
+        case ASTNodeKind::And:
+        case ASTNodeKind::Or:
+        {
+            bool decider = node.kind == ASTNodeKind::Or;
+            a = a.ToBool();
+            if (a.IsKnown() && a.boolValue == decider) return a;
+            b = b.ToBool();
+            return a.IsKnown() ? b : ConstantValue();
+        }
+
+        default:
+            return ConstantValue();
+
+    }
+}
+
+ConstantValue ConstantFolder::EvaluateUnary(ASTNodeKind kind, ConstantValue operand)
+{
+    switch (kind)
+    {
+
+        // Ints wrap around like the subtraction from 0 they compile to.
+        case ASTNodeKind::Negation:
+            if (operand.kind == ConstantValue::Kind::Int) return ConstantValue::Int((int)(0u - (unsigned)operand.intValue));
+            if (operand.kind == ConstantValue::Kind::Float) return ConstantValue::Float(-operand.floatValue);
+            return ConstantValue();
+
+        // Every int is exact as a double.
+        case ASTNodeKind::Int2Float:
+            return operand.kind == ConstantValue::Kind::Int ? ConstantValue::Float((double)operand.intValue) : operand;
+
+        // Floats are truncated toward zero. The result of converting a float out of the range of an int (or NaN) is undefined, so those are not folded.
+        case ASTNodeKind::Float2Int:
+            if (operand.kind != ConstantValue::Kind::Float) return operand;
+            if (!(operand.floatValue > -2147483649.0 && operand.floatValue < 2147483648.0)) return ConstantValue();
+            return ConstantValue::Int((int)operand.floatValue);
+
+        case ASTNodeKind::Int2Bool:
+            return operand.kind == ConstantValue::Kind::Int ? ConstantValue::Bool(operand.intValue != 0) : operand;
+
+        case ASTNodeKind::Bool2Int:
+            return operand.kind == ConstantValue::Kind::Bool ? ConstantValue::Int(operand.boolValue ? 1 : 0) : operand;
+
+        default:
+            return ConstantValue();
+
+    }
+}
+
+void ConstantFolder::FoldFunction(ASTFunction& function)
+{
+    FoldStatement(function.definition, false);
+}
+
+ConstantValue ConstantFolder::FoldOperand(std::unique_ptr<ASTExpression>& operand)
+{
+    value = ConstantValue();
+    operand->Accept(*this);
+    ConstantValue result = value;
+    if (result.IsKnown() && !IsLiteral(operand.get()))
+    {
+        operand = result.MakeLiteral();
+        foldedExpressions++;
+    }
+    return result;
+}
+
+void ConstantFolder::FoldStatement(std::unique_ptr<ASTStatement>& node, bool canRemove)
+{
+    if (!node) return;
+    replace = false;
+    value = ConstantValue();
+    node->Accept(*this);
+
+    // A statement that is only a constant does nothing.
+    if (node->IsExpression() && value.IsKnown())
+    {
+        replace = true;
+        replacement = nullptr;
+        if (!IsLiteral(node.get())) foldedExpressions++;
+    }
+    else if (replace) prunedBranches++;
+    if (!replace) return;
+    replace = false;
+    node = std::move(replacement);
+    if (!node && !canRemove) node = std::make_unique<ASTStatementBlock>();
+
+}
+
+void ConstantFolder::Visit(ASTStatementBlock& node)
+{
+    // Removed statements are left null and compacted away at the end, like in dead code elimination.
+    for (auto& statement : node.statements) FoldStatement(statement, true);
+    node.statements.erase(std::remove(node.statements.begin(), node.statements.end(), nullptr), node.statements.end());
+}
+
+void ConstantFolder::Visit(ASTStatementIf& node)
+{
+    ConstantValue condition = FoldOperand(node.condition);
+    FoldStatement(node.thenStatement, false);
+    FoldStatement(node.elseStatement, true);
+
+    // Only bool conditions are pruned. Any other type is an error type checking should still report.
+    if (condition.kind != ConstantValue::Kind::Bool) return;
+    replace = true;
+    replacement = std::move(condition.boolValue ? node.thenStatement : node.elseStatement);
+
+}
+
+void ConstantFolder::Visit(ASTStatementWhile& node)
+{
+    ConstantValue condition = FoldOperand(node.condition);
+    FoldStatement(node.thenStatement, false);
+    if (condition.kind != ConstantValue::Kind::Bool || condition.boolValue) return;
+    replace = true; // The body never runs, and the condition has no effects since it is a constant.
+    replacement = nullptr;
+}
+
+void ConstantFolder::Visit(ASTStatementFor& node)
+{
+    FoldStatement(node.init, true);
+    ConstantValue condition = node.condition ? FoldOperand(node.condition) : ConstantValue();
+    FoldStatement(node.increment, true);
+    FoldStatement(node.body, false);
+    if (condition.kind != ConstantValue::Kind::Bool || condition.boolValue) return;
+    replace = true; // Only the init runs.
+    replacement = std::move(node.init);
+}
+
+void ConstantFolder::Visit(ASTStatementReturn& node)
+{
+    if (node.returnExpression) FoldOperand(node.returnExpression);
+    value = ConstantValue();
+}
+
+void ConstantFolder::Visit(ASTExpressionInt& node)
+{
+    value = ConstantValue::Int(node.value);
+}
+
+void ConstantFolder::Visit(ASTExpressionFloat& node)
+{
+    value = ConstantValue::Float(node.value);
+}
+
+void ConstantFolder::Visit(ASTExpressionBool& node)
+{
+    value = ConstantValue::Bool(node.value);
+}
+
+void ConstantFolder::Visit(ASTExpressionCall& node)
+{
+    for (auto& argument : node.arguments) FoldOperand(argument);
+    value = ConstantValue();
+}
+
+void ConstantFolder::Visit(ASTExpressionAssignment& node)
+{
+    FoldOperand(node.right);
+    value = ConstantValue(); // The assignment has an effect, so it is never replaced even if its value is known.
+}
+
+void ConstantFolder::Visit(ASTExpressionBinary& node)
+{
+    // The right operand of && and || is folded even if the left one decides the result, since the whole node is replaced then anyway.
+    ConstantValue a = FoldOperand(node.a1);
+    ConstantValue b = FoldOperand(node.a2);
+    value = EvaluateBinary(node, a, b);
+}
+
+void ConstantFolder::Visit(ASTExpressionNegation& node)
+{
+    value = EvaluateUnary(node.kind, FoldOperand(node.operand));
+}
+
+void ConstantFolder::Visit(ASTExpressionInt2Float& node)
+{
+    value = EvaluateUnary(node.kind, FoldOperand(node.operand));
+}
+
+void ConstantFolder::Visit(ASTExpressionFloat2Int& node)
+{
+    value = EvaluateUnary(node.kind, FoldOperand(node.operand));
+}
+
+void ConstantFolder::Visit(ASTExpressionInt2Bool& node)
+{
+    value = EvaluateUnary(node.kind, FoldOperand(node.operand));
+}
+
+void ConstantFolder::Visit(ASTExpressionBool2Int& node)
+{
+    value = EvaluateUnary(node.kind, FoldOperand(node.operand));
+}
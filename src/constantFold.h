@@ -0,0 +1,134 @@
+#pragma once
+
+#include "expression.h"
+#include "visitor.h"
+#include <cstdint>
+#include <memory>
+
+// A value an expression is known to always have, or unknown.
+struct ConstantValue
+{
+
+    // Type of the value.
+    enum class Kind : uint8_t
+    {
+        Unknown, // The value can't be known at compile time.
+        Int,
+        Float,
+        Bool
+    };
+
+    // Type of the value.
+    Kind kind = Kind::Unknown;
+
+    // The value, of the field matching the kind.
+    union
+    {
+        int intValue;
+        double floatValue;
+        bool boolValue;
+    };
+
+    // Create an unknown value.
+    ConstantValue() : intValue(0) {}
+
+    // Create a known value.
+    // value: Value of the constant.
+    static ConstantValue Int(int value) { ConstantValue ret; ret.kind = Kind::Int; ret.intValue = value; return ret; }
+    static ConstantValue Float(double value) { ConstantValue ret; ret.kind = Kind::Float; ret.floatValue = value; return ret; }
+    static ConstantValue Bool(bool value) { ConstantValue ret; ret.kind = Kind::Bool; ret.boolValue = value; return ret; }
+
+    // If the value is known.
+    bool IsKnown() const { return kind != Kind::Unknown; }
+
+    // Convert the value like an implicit cast to bool does: ints are true if not 0, and floats are converted to int first.
+    // Returns: The value as a bool, or unknown if it can't be converted at compile time.
+    ConstantValue ToBool() const;
+
+    // Convert the value like an implicit cast to a type does, like when it is assigned to a variable of that type.
+    // type: Type to convert to.
+    // Returns: The converted value, or unknown if it can't be converted at compile time.
+    ConstantValue ImplicitCast(const VarType* type) const;
+
+    // If two values are known and the same. Floats are compared by their bits, so NaN is the same as itself.
+    // other: Value to compare to.
+    bool SameAs(const ConstantValue& other) const;
+
+    // Make a literal node with the value. Must be known.
+    // Returns: The new literal.
+    std::unique_ptr<ASTExpression> MakeLiteral() const;
+
+};
+
+// Evaluates expressions made only of constants at compile time, and replaces them with literals.
+// Values follow what the generated code would do after type checking: ints wrap around, floats are doubles, and casts are the implicit ones type checking adds. Operations the code generator would reject, like arithmetic on bools, are left alone so they still give an error.
+// Ifs whose condition becomes a constant bool are replaced by the branch taken, and loops whose condition is always false are removed, so neither reaches the code generator.
+class ConstantFolder : public ASTMutator
+{
+
+    // Value of the expression visited last.
+    ConstantValue value;
+
+    // Set by visiting a statement that should be replaced by replacement, which may be null to remove it.
+    bool replace = false;
+    std::unique_ptr<ASTStatement> replacement;
+
+    // Fold constants in an operand, and replace it with a literal if it has a known value.
+    // operand: Operand to fold in.
+    // Returns: Value of the operand.
+    ConstantValue FoldOperand(std::unique_ptr<ASTExpression>& operand);
+
+    // Fold constants in a statement, and replace it if it is an if or loop that can be pruned.
+    // node: Statement to fold in. May be null.
+    // canRemove: If the statement can be left null when it is removed. If not, it is replaced with an empty block.
+    void FoldStatement(std::unique_ptr<ASTStatement>& node, bool canRemove);
+
+public:
+
+    // Number of expressions replaced by literals so far.
+    size_t foldedExpressions = 0;
+
+    // Number of ifs and loops pruned so far.
+    size_t prunedBranches = 0;
+
+    // Fold constants in the body of a function.
+    // function: Function to fold in. May be only declared.
+    void FoldFunction(ASTFunction& function);
+
+    // Find the value of an expression without changing it.
+    // expr: Expression to evaluate. May be null.
+    // Returns: Its value, or unknown if it isn't made only of constants.
+    static ConstantValue Evaluate(const ASTStatement* expr);
+
+    // Find the value of a binary operator from the values of its operands. Evaluate and the folding both go through this, so they always agree.
+    // node: Operator node. Only its kind and comparison type are used.
+    // a: Value of the left operand.
+    // b: Value of the right operand. It is not needed if the left one decides an && or ||.
+    // Returns: Value of the operation, or unknown if it can't be found at compile time.
+    static ConstantValue EvaluateBinary(const ASTExpressionBinary& node, ConstantValue a, ConstantValue b);
+
+    // Find the value of a negation or cast from the value of its operand.
+    // kind: Kind of the node.
+    // operand: Value of the operand.
+    // Returns: Value of the operation, or unknown if it can't be found at compile time.
+    static ConstantValue EvaluateUnary(ASTNodeKind kind, ConstantValue operand);
+
+    // Virtual functions. See base class for details.
+    void Visit(ASTStatementBlock& node) override;
+    void Visit(ASTStatementIf& node) override;
+    void Visit(ASTStatementWhile& node) override;
+    void Visit(ASTStatementFor& node) override;
+    void Visit(ASTStatementReturn& node) override;
+    void Visit(ASTExpressionInt& node) override;
+    void Visit(ASTExpressionFloat& node) override;
+    void Visit(ASTExpressionBool& node) override;
+    void Visit(ASTExpressionCall& node) override;
+    void Visit(ASTExpressionAssignment& node) override;
+    void Visit(ASTExpressionBinary& node) override;
+    void Visit(ASTExpressionNegation& node) override;
+    void Visit(ASTExpressionInt2Float& node) override;
+    void Visit(ASTExpressionFloat2Int& node) override;
+    void Visit(ASTExpressionInt2Bool& node) override;
+    void Visit(ASTExpressionBool2Int& node) override;
+
+};
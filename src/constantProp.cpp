@@ -0,0 +1,290 @@
+#include "constantProp.h"
+
+#include "function.h"
+#include "expressions/assignment.h"
+#include "expressions/binary.h"
+#include "expressions/bool2Int.h"
+#include "expressions/float2Int.h"
+#include "expressions/int2Bool.h"
+#include "expressions/int2Float.h"
+#include "expressions/negative.h"
+#include "expressions/variable.h"
+
+bool ConstantPropagator::PropagateFunction(ASTFunction& function)
+{
+    if (!function.definition) return false;
+    CFG cfg(function);
+    SSAForm ssa(cfg);
+    this->function = &function;
+    this->cfg = &cfg;
+    this->ssa = &ssa;
+
+    // Index the accesses, so reads found while evaluating an expression can be looked up.
+    types.clear();
+    for (Symbol var : cfg.variables) types.push_back(function.GetVariableType(var));
+    accessOf.clear();
+    accessBlocks.assign(cfg.accesses.size(), CFG_NONE);
+    for (CFGBlockId block = 0; block < cfg.blocks.size(); block++)
+    {
+        auto& info = cfg.blocks[block];
+        for (uint32_t i = info.firstAccess; i < info.firstAccess + info.accessCount; i++)
+        {
+            accessOf.emplace(cfg.accesses[i].node, i);
+            accessBlocks[i] = block;
+        }
+    }
+    otherReaders.clear();
+    for (CFGBlockId block = 0; block < cfg.blocks.size(); block++)
+    {
+        auto& info = cfg.blocks[block];
+        for (uint32_t i = info.firstAccess; i < info.firstAccess + info.accessCount; i++)
+        {
+            if (cfg.accesses[i].kind == CFGAccessKind::Def) AddReaders(static_cast<const ASTExpressionAssignment*>(cfg.accesses[i].node)->right.get(), block);
+        }
+        if (info.condition) AddReaders(info.condition, block);
+    }
+
+    // Parameters can be anything. Other variables are not initialized, so they are anything too.
+    values.assign(ssa.values.size(), PropagatedValue());
+    for (uint32_t var = 0; var < cfg.variables.size(); var++) values[var] = PropagatedValue::Varying();
+
+    // Visit blocks as they are found to run, and again whenever something they use changes, until nothing changes.
+    executable.assign(cfg.blocks.size(), false);
+    executableEdges.resize(cfg.blocks.size());
+    for (CFGBlockId block = 0; block < cfg.blocks.size(); block++) executableEdges[block].assign(cfg.blocks[block].predecessors.size(), false);
+    queued.assign(cfg.blocks.size(), false);
+    executable[CFG::ENTRY] = true;
+    Queue(CFG::ENTRY);
+    while (!work.empty())
+    {
+        CFGBlockId block = work.back();
+        work.pop_back();
+        queued[block] = false;
+        VisitBlock(block);
+    }
+
+    // Replace reads of constants in blocks that run. Reads held as statements of their own do nothing, so they are left for dead code elimination.
+    size_t replacedBefore = replacedReads;
+    for (uint32_t i = 0; i < cfg.accesses.size(); i++)
+    {
+        auto& access = cfg.accesses[i];
+        if (access.kind != CFGAccessKind::Use || !access.slot || !executable[accessBlocks[i]]) continue;
+        auto& known = values[ssa.accessValues[i]];
+        if (known.state != PropagatedValue::State::Constant) continue;
+        *access.slot = known.constant.MakeLiteral();
+        replacedReads++;
+    }
+    for (CFGBlockId block = 0; block < cfg.blocks.size(); block++)
+    {
+        if (ssa.dominators.IsReachable(block) && !executable[block]) unreachableBlocks++;
+    }
+
+    // The CFG points into the body, which has changed.
+    this->function = nullptr;
+    this->cfg = nullptr;
+    this->ssa = nullptr;
+    return replacedReads != replacedBefore;
+
+}
+
+void ConstantPropagator::Queue(CFGBlockId block)
+{
+    if (!executable[block] || queued[block]) return;
+    queued[block] = true;
+    work.push_back(block);
+}
+
+void ConstantPropagator::AddReaders(const ASTExpression* expr, CFGBlockId block)
+{
+    switch (expr->kind)
+    {
+
+        // Evaluate does not look into nested assignments, since they have an access of their own.
+        case ASTNodeKind::Variable:
+        case ASTNodeKind::Assignment:
+        {
+            auto found = accessOf.find(expr);
+            if (found != accessOf.end() && accessBlocks[found->second] != block) otherReaders[found->second].push_back(block);
+            break;
+        }
+
+        case ASTNodeKind::Addition:
+        case ASTNodeKind::Subtraction:
+        case ASTNodeKind::Multiplication:
+        case ASTNodeKind::Division:
+        case ASTNodeKind::Comparison:
+        case ASTNodeKind::And:
+        case ASTNodeKind::Or:
+            AddReaders(static_cast<const ASTExpressionBinary*>(expr)->a1.get(), block);
+            AddReaders(static_cast<const ASTExpressionBinary*>(expr)->a2.get(), block);
+            break;
+
+        default:
+            if (auto operand = UnaryOperand(expr)) AddReaders(operand, block);
+            break;
+
+    }
+}
+
+void ConstantPropagator::QueueReaders(uint32_t access)
+{
+    auto found = otherReaders.find(access);
+    if (found == otherReaders.end()) return;
+    for (CFGBlockId block : found->second) Queue(block);
+}
+
+void ConstantPropagator::MarkEdge(CFGBlockId from, CFGBlockId to)
+{
+    auto& preds = cfg->blocks[to].predecessors;
+    bool changed = false;
+    for (size_t j = 0; j < preds.size(); j++)
+    {
+        if (preds[j] != from || executableEdges[to][j]) continue;
+        executableEdges[to][j] = true;
+        changed = true;
+    }
+    if (!changed) return;
+    executable[to] = true;
+    Queue(to); // Its phis have a new operand, or it runs for the first time.
+}
+
+void ConstantPropagator::Update(SSAValueId value, PropagatedValue known)
+{
+    auto& current = values[value];
+    if (current.state == PropagatedValue::State::Varying || known.state == PropagatedValue::State::Undefined) return;
+    if (current.state == PropagatedValue::State::Constant)
+    {
+        if (known.state == PropagatedValue::State::Constant && known.constant.SameAs(current.constant)) return;
+        known = PropagatedValue::Varying(); // Two different constants.
+    }
+    current = known;
+    auto& info = ssa->values[value];
+    if (info.access != UINT32_MAX) QueueReaders(info.access);
+    for (uint32_t use : info.uses)
+    {
+        Queue(accessBlocks[use]);
+        QueueReaders(use);
+    }
+    for (SSAValueId phi : info.phiUses) Queue(ssa->values[phi].block);
+}
+
+void ConstantPropagator::VisitBlock(CFGBlockId block)
+{
+
+    // A phi is the meet of the values coming in over edges that can be taken.
+    auto& info = cfg->blocks[block];
+    for (SSAValueId phi : ssa->phis[block])
+    {
+        auto& operands = ssa->values[phi].operands;
+        for (size_t j = 0; j < operands.size(); j++)
+        {
+            if (executableEdges[block][j] && operands[j] != SSA_NONE) Update(phi, values[operands[j]]);
+        }
+    }
+
+    // Assignments store their value converted to the type of the variable.
+    for (uint32_t i = info.firstAccess; i < info.firstAccess + info.accessCount; i++)
+    {
+        auto& access = cfg->accesses[i];
+        if (access.kind != CFGAccessKind::Def) continue;
+        PropagatedValue known = Evaluate(static_cast<const ASTExpressionAssignment*>(access.node)->right.get());
+        if (known.state == PropagatedValue::State::Constant) known = PropagatedValue::Constant(known.constant.ImplicitCast(types[access.var]));
+        Update(ssa->accessValues[i], known);
+    }
+
+    // Only follow the successors the condition can go to. If and loop conditions have to be bools already, while && and || cast their operands to bool.
+    if (!info.condition)
+    {
+        for (CFGBlockId successor : info.successors) MarkEdge(block, successor);
+        return;
+    }
+    PropagatedValue condition = Evaluate(info.condition);
+    if (condition.state == PropagatedValue::State::Undefined) return;
+    if (condition.state == PropagatedValue::State::Constant)
+    {
+        ConstantValue value = condition.constant;
+        if (info.branch->kind == ASTNodeKind::And || info.branch->kind == ASTNodeKind::Or) value = value.ToBool();
+        if (value.kind == ConstantValue::Kind::Bool)
+        {
+            MarkEdge(block, info.successors[value.boolValue ? 0 : 1]);
+            return;
+        }
+    }
+    MarkEdge(block, info.successors[0]);
+    MarkEdge(block, info.successors[1]);
+
+}
+
+PropagatedValue ConstantPropagator::Evaluate(const ASTExpression* expr) const
+{
+    switch (expr->kind)
+    {
+
+        case ASTNodeKind::Int:
+        case ASTNodeKind::Float:
+        case ASTNodeKind::Bool:
+            return PropagatedValue::Constant(ConstantFolder::Evaluate(expr));
+
+        // Reads and nested assignments have the value of their access, which is found before anything that uses it in the same block.
+        case ASTNodeKind::Variable:
+        case ASTNodeKind::Assignment:
+        {
+            auto found = accessOf.find(expr);
+            if (found == accessOf.end()) return PropagatedValue::Varying(); // Not a variable of the function.
+            SSAValueId value = ssa->accessValues[found->second];
+            return value == SSA_NONE ? PropagatedValue::Varying() : values[value];
+        }
+
+        // The right operand only matters if the left one does not decide the result.
+        case ASTNodeKind::And:
+        case ASTNodeKind::Or:
+        {
+            auto binary = static_cast<const ASTExpressionBinary*>(expr);
+            PropagatedValue left = Evaluate(binary->a1.get());
+            if (left.state != PropagatedValue::State::Constant) return left;
+            ConstantValue result = ConstantFolder::EvaluateBinary(*binary, left.constant, ConstantValue());
+            if (result.IsKnown()) return PropagatedValue::Constant(result);
+            PropagatedValue right = Evaluate(binary->a2.get());
+            if (right.state != PropagatedValue::State::Constant) return right;
+            return PropagatedValue::Constant(ConstantFolder::EvaluateBinary(*binary, left.constant, right.constant));
+        }
+
+        case ASTNodeKind::Addition:
+        case ASTNodeKind::Subtraction:
+        case ASTNodeKind::Multiplication:
+        case ASTNodeKind::Division:
+        case ASTNodeKind::Comparison:
+        {
+            auto binary = static_cast<const ASTExpressionBinary*>(expr);
+            PropagatedValue left = Evaluate(binary->a1.get());
+            PropagatedValue right = Evaluate(binary->a2.get());
+            if (left.state == PropagatedValue::State::Varying || right.state == PropagatedValue::State::Varying) return PropagatedValue::Varying();
+            if (left.state == PropagatedValue::State::Undefined || right.state == PropagatedValue::State::Undefined) return PropagatedValue();
+            return PropagatedValue::Constant(ConstantFolder::EvaluateBinary(*binary, left.constant, right.constant));
+        }
+
+        // Negations and casts. Calls can do anything, and strings are never constant.
+        default:
+        {
+            auto operand = UnaryOperand(expr);
+            if (!operand) return PropagatedValue::Varying();
+            PropagatedValue known = Evaluate(operand);
+            if (known.state != PropagatedValue::State::Constant) return known;
+            return PropagatedValue::Constant(ConstantFolder::EvaluateUnary(expr->kind, known.constant));
+        }
+
+    }
+}
+
+const ASTExpression* ConstantPropagator::UnaryOperand(const ASTExpression* expr)
+{
+    switch (expr->kind)
+    {
+        case ASTNodeKind::Negation: return static_cast<const ASTExpressionNegation*>(expr)->operand.get();
+        case ASTNodeKind::Int2Float: return static_cast<const ASTExpressionInt2Float*>(expr)->operand.get();
+        case ASTNodeKind::Float2Int: return static_cast<const ASTExpressionFloat2Int*>(expr)->operand.get();
+        case ASTNodeKind::Int2Bool: return static_cast<const ASTExpressionInt2Bool*>(expr)->operand.get();
+        case ASTNodeKind::Bool2Int: return static_cast<const ASTExpressionBool2Int*>(expr)->operand.get();
+        default: return nullptr;
+    }
+}
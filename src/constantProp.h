@@ -0,0 +1,121 @@
+#pragma once
+
+#include "constantFold.h"
+#include "ssa.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// What is known about a value while propagating constants. Values only ever go down from undefined to constant to varying, which is what makes propagation stop.
+struct PropagatedValue
+{
+
+    // How much is known.
+    enum class State : uint8_t
+    {
+        Undefined, // Nothing that makes the value has been found to run yet.
+        Constant, // The value is always constant.
+        Varying // The value can't be known at compile time.
+    };
+
+    // How much is known.
+    State state = State::Undefined;
+
+    // The value if it is constant.
+    ConstantValue constant;
+
+    // Create a constant value, which is varying if the constant is unknown.
+    // constant: The value.
+    static PropagatedValue Constant(ConstantValue constant) { return constant.IsKnown() ? PropagatedValue { State::Constant, constant } : Varying(); }
+
+    // Create a varying value.
+    static PropagatedValue Varying() { return PropagatedValue { State::Varying }; }
+
+};
+
+// Propagates constants across the statements of a function with sparse conditional constant propagation (Wegman and Zadeck).
+// Values are tracked per SSA value of the function's CFG, and only branches that can be taken given the values found so far are followed. So a variable assigned a constant keeps it through branches that can't run, and code only reachable through them is ignored.
+// Reads of variables that are always constant are replaced by literals. Constant folding afterwards then folds the expressions they are in and prunes the branches that are never taken.
+class ConstantPropagator
+{
+
+    // Function being propagated in, with its CFG and SSA form.
+    ASTFunction* function = nullptr;
+    const CFG* cfg = nullptr;
+    const SSAForm* ssa = nullptr;
+
+    // Type of each variable, by number.
+    std::vector<const VarType*> types;
+
+    // Access of each variable read and assignment node.
+    std::unordered_map<const ASTStatement*, uint32_t> accessOf;
+
+    // Block of each access.
+    std::vector<CFGBlockId> accessBlocks;
+
+    // Blocks other than its own that evaluate an access, because it is in the right operand of an && or || their assignments or condition use.
+    std::unordered_map<uint32_t, std::vector<CFGBlockId>> otherReaders;
+
+    // What is known about each SSA value.
+    std::vector<PropagatedValue> values;
+
+    // If each block can run, and which edges from its predecessors can be taken, in the order of the predecessors.
+    std::vector<bool> executable;
+    std::vector<std::vector<bool>> executableEdges;
+
+    // Blocks to visit again, and if each one is in the list.
+    std::vector<CFGBlockId> work;
+    std::vector<bool> queued;
+
+    // Add a block to the blocks to visit, if it can run.
+    // block: Block to visit.
+    void Queue(CFGBlockId block);
+
+    // Add a block to the blocks to visit for every access an expression evaluates that is in another block.
+    // expr: Expression the block evaluates.
+    // block: Block that evaluates it.
+    void AddReaders(const ASTExpression* expr, CFGBlockId block);
+
+    // Visit the blocks that evaluate an access again.
+    // access: Access whose value changed.
+    void QueueReaders(uint32_t access);
+
+    // Mark an edge as one that can be taken, and visit the block it goes to.
+    // from: Block control leaves.
+    // to: Block control goes to.
+    void MarkEdge(CFGBlockId from, CFGBlockId to);
+
+    // Lower what is known about an SSA value, and visit the blocks that use it if it changed.
+    // value: SSA value to update.
+    // known: What was found about it.
+    void Update(SSAValueId value, PropagatedValue known);
+
+    // Find the phis, assignments and branch of a block with what is known so far.
+    // block: Block to visit.
+    void VisitBlock(CFGBlockId block);
+
+    // Find what is known about an expression from what is known about the variables it reads.
+    // expr: Expression to evaluate.
+    // Returns: What is known about its value.
+    PropagatedValue Evaluate(const ASTExpression* expr) const;
+
+    // Get the operand of a negation or cast.
+    // expr: Expression to get the operand of.
+    // Returns: The operand, or null if the expression is not a negation or cast.
+    static const ASTExpression* UnaryOperand(const ASTExpression* expr);
+
+public:
+
+    // Number of variable reads replaced by constants so far.
+    size_t replacedReads = 0;
+
+    // Number of blocks found to never run so far, not counting code after a return.
+    size_t unreachableBlocks = 0;
+
+    // Propagate constants in the body of a function, replacing reads of constant variables with literals.
+    // function: Function to propagate in. May be only declared.
+    // Returns: If any reads were replaced.
+    bool PropagateFunction(ASTFunction& function);
+
+};
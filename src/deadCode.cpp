@@ -0,0 +1,309 @@
+#include "deadCode.h"
+
+#include "constantFold.h"
+#include "function.h"
+#include "statements/block.h"
+#include "statements/for.h"
+#include "statements/if.h"
+#include "statements/return.h"
+#include "statements/while.h"
+#include "expressions/and.h"
+#include "expressions/arithmetic.h"
+#include "expressions/assignment.h"
+#include "expressions/bool2Int.h"
+#include "expressions/bool.h"
+#include "expressions/call.h"
+#include "expressions/float2Int.h"
+#include "expressions/int2Bool.h"
+#include "expressions/int2Float.h"
+#include "expressions/negative.h"
+#include "expressions/or.h"
+#include "expressions/variable.h"
+#include <algorithm>
+
+int UnreachableCodeEliminator::EvaluateExpression(const ASTStatement* expr)
+{
+    // Conditions have to be bools, so other constants are left for type checking to report.
+    ConstantValue value = ConstantFolder::Evaluate(expr);
+    if (value.kind != ConstantValue::Kind::Bool) return 2;
+    return value.boolValue ? 1 : 0;
+}
+
+void UnreachableCodeEliminator::Visit(ASTStatementIf& node)
+{
+    int condVal = EvaluateExpression(node.condition.get());
+    if (condVal == 1 && node.elseStatement)
+    {
+        node.elseStatement = nullptr; // Expression is always true, else is unreachable.
+        removed = true;
+    }
+    else if (condVal == 0 && node.thenStatement)
+    {
+        node.thenStatement = nullptr; // Expression is always false, then is unreachable.
+        removed = true;
+    }
+}
+
+void UnreachableCodeEliminator::Visit(ASTStatementWhile& node)
+{
+    if (node.thenStatement && EvaluateExpression(node.condition.get()) == 0)
+    {
+        node.thenStatement = nullptr; // Loop condition is false, loop body is unreachable.
+        removed = true;
+    }
+}
+
+void UnreachableCodeEliminator::Visit(ASTStatementFor& node)
+{
+    if (node.body && EvaluateExpression(node.condition.get()) == 0)
+    {
+        node.body = nullptr; // Loop condition is false, loop body is unreachable.
+        removed = true;
+    }
+}
+
+void DeadCodeEliminator::EliminateFunction(ASTFunction& function)
+{
+    if (!function.definition) return;
+
+    // Parameters are among the stack variables, so this numbers every variable.
+    indices.clear();
+    loops.clear();
+    changed = false;
+    for (uint32_t i = 0; i < function.stackVariables.size(); i++) indices.emplace(function.stackVariables[i], i);
+
+    // Nothing is live once the function returns.
+    LiveSet live(function.stackVariables.size());
+    Eliminate(function.definition.get(), live, true, true);
+
+}
+
+bool DeadCodeEliminator::Eliminate(ASTStatement* node, LiveSet& variables, bool eliminate, bool statement)
+{
+    if (!node) return false;
+
+    // Visit with the given state, then put back the state of the parent.
+    LiveSet* parentVariables = this->variables;
+    bool parentEliminate = this->eliminate;
+    bool parentStatement = this->statement;
+    this->variables = &variables;
+    this->eliminate = eliminate;
+    this->statement = statement;
+    bool parentChanged = changed;
+    changed = false;
+    dead = false;
+    node->Accept(*this);
+    bool result = dead;
+    if (changed)
+    {
+        if (auto loop = ASTCast<ASTStatementWhile>(node)) loop->tripCount = -1;
+        else if (auto loop = ASTCast<ASTStatementFor>(node)) loop->tripCount = -1;
+    }
+    changed |= parentChanged || result; // The caller removes a dead assignment.
+    this->variables = parentVariables;
+    this->eliminate = parentEliminate;
+    this->statement = parentStatement;
+    dead = false;
+    return result;
+
+}
+
+template <typename T>
+void DeadCodeEliminator::RemoveUnreachable(T& node)
+{
+    unreachable.removed = false;
+    unreachable.Visit(node);
+    changed |= unreachable.removed;
+}
+
+template <typename T>
+void DeadCodeEliminator::EliminateOperand(std::unique_ptr<T>& operand)
+{
+    if (Eliminate(operand.get(), *variables, eliminate)) operand = std::move(static_cast<ASTExpressionAssignment*>(operand.get())->right);
+}
+
+template <typename WalkIteration>
+const LiveSet& DeadCodeEliminator::SolveLoop(const ASTStatement& loop, ASTStatement* condition, WalkIteration walkIteration)
+{
+    LoopState& state = loops[&loop];
+    if (state.solved && state.liveOut == *variables) return state.head;
+
+    // Liveness only grows as the code around the loop is walked again, so the last head is a starting point below the new one.
+    if (!state.solved) state.head = LiveSet(indices.size());
+    state.liveOut = *variables;
+    state.solved = true;
+
+    // The end of an iteration goes back to the head, and the head either exits the loop or starts another iteration.
+    bool changed;
+    do
+    {
+        LiveSet live = state.head;
+        walkIteration(live);
+        live.UnionWith(state.liveOut);
+        Eliminate(condition, live, false);
+        changed = state.head.UnionWith(live);
+    } while (changed);
+    return state.head;
+
+}
+
+bool DeadCodeEliminator::HasEffects(const ASTStatement* value)
+{
+    return value->kind == ASTNodeKind::Assignment || value->kind == ASTNodeKind::Call;
+}
+
+void DeadCodeEliminator::EliminateAssignmentStmt(std::unique_ptr<ASTStatement>& node)
+{
+    auto assignment = static_cast<ASTExpressionAssignment*>(node.get());
+    if (HasEffects(assignment->right.get())) node = std::move(assignment->right); // The value still has effects.
+    else node = nullptr;
+}
+
+void DeadCodeEliminator::Visit(ASTStatementBlock& node)
+{
+    // Iterate through children in reverse order, removing dead assignments.
+    // Removed statements are left null and compacted away in a single pass at the end, since erasing each one would shift the rest of the block every time.
+    for (size_t i = node.statements.size(); i-- > 0;)
+    {
+        if (Eliminate(node.statements[i].get(), *variables, eliminate, true)) EliminateAssignmentStmt(node.statements[i]);
+    }
+    node.statements.erase(std::remove(node.statements.begin(), node.statements.end(), nullptr), node.statements.end());
+}
+
+void DeadCodeEliminator::Visit(ASTStatementIf& node)
+{
+    RemoveUnreachable(node);
+
+    // Each branch starts from what is live after the if, and a variable is live before it if it is live in either branch.
+    LiveSet elseVars(*variables);
+    if (Eliminate(node.elseStatement.get(), elseVars, eliminate, true)) EliminateAssignmentStmt(node.elseStatement);
+    if (Eliminate(node.thenStatement.get(), *variables, eliminate, true)) EliminateAssignmentStmt(node.thenStatement);
+    variables->UnionWith(elseVars);
+    EliminateOperand(node.condition);
+
+}
+
+void DeadCodeEliminator::Visit(ASTStatementWhile& node)
+{
+    RemoveUnreachable(node);
+    LiveSet live = SolveLoop(node, node.condition.get(), [&](LiveSet& live)
+    {
+        Eliminate(node.thenStatement.get(), live, false, true);
+    });
+    if (!eliminate)
+    {
+        *variables = live;
+        return;
+    }
+
+    // With the head known, a single walk of the body finds everything dead in it.
+    if (Eliminate(node.thenStatement.get(), live, eliminate, true)) EliminateAssignmentStmt(node.thenStatement);
+    variables->UnionWith(live);
+    EliminateOperand(node.condition);
+
+}
+
+void DeadCodeEliminator::Visit(ASTStatementFor& node)
+{
+    RemoveUnreachable(node);
+    LiveSet live = SolveLoop(node, node.condition.get(), [&](LiveSet& live)
+    {
+        Eliminate(node.increment.get(), live, false);
+        Eliminate(node.body.get(), live, false, true);
+    });
+    if (!eliminate) *variables = live;
+    else
+    {
+
+        // With the head known, a single walk of the body and increment finds everything dead in them.
+        if (Eliminate(node.increment.get(), live, eliminate)) node.increment = std::move(static_cast<ASTExpressionAssignment*>(node.increment.get())->right);
+        if (Eliminate(node.body.get(), live, eliminate, true)) EliminateAssignmentStmt(node.body);
+        variables->UnionWith(live);
+        EliminateOperand(node.condition);
+
+    }
+    if (Eliminate(node.init.get(), *variables, eliminate, true)) EliminateAssignmentStmt(node.init);
+
+}
+
+void DeadCodeEliminator::Visit(ASTStatementReturn& node)
+{
+    *variables = LiveSet(indices.size()); // Nothing after a return is run.
+    EliminateOperand(node.returnExpression);
+}
+
+void DeadCodeEliminator::Visit(ASTExpressionVariable& node)
+{
+    auto found = indices.find(node.var);
+    if (found != indices.end()) variables->Set(found->second); // Reading a variable makes it live.
+}
+
+void DeadCodeEliminator::Visit(ASTExpressionCall& node)
+{
+    // Calls are made on variables (function names), which makes that function live.
+    if (auto callee = ASTCast<ASTExpressionVariable>(node.callee.get())) functions.emplace(callee->var, true);
+
+    // Iterate through children in reverse order, removing dead assignments.
+    for (int i = (int)node.arguments.size() - 1; i >= 0; i--) EliminateOperand(node.arguments[i]);
+
+}
+
+void DeadCodeEliminator::Visit(ASTExpressionAssignment& node)
+{
+    // Assignments exclusively assign to variables, so no further checking is required.
+    auto left = static_cast<ASTExpressionVariable*>(node.left.get());
+
+    // If variable is live, it is dead before the assignment but the assignment stays, otherwise, mark assignment for removal.
+    auto found = indices.find(left->var);
+    if (found != indices.end() && variables->Test(found->second))
+    {
+        variables->Reset(found->second);
+        EliminateOperand(node.right);
+    }
+    else
+    {
+        // The value stays if this is an operand or it has effects, so what it reads is still live. Only a statement drops a value without effects.
+        if (!statement || HasEffects(node.right.get())) EliminateOperand(node.right);
+        dead = eliminate;
+    }
+
+}
+
+void DeadCodeEliminator::Visit(ASTExpressionBinary& node)
+{
+    // Operands run left to right, so walking backwards visits the right one first.
+    // The right operand of && and || may be skipped, so like the branch of an if without an else, it can't make a variable dead that is live after it.
+    if (node.kind == ASTNodeKind::And || node.kind == ASTNodeKind::Or)
+    {
+        LiveSet skipped(*variables);
+        EliminateOperand(node.a2);
+        variables->UnionWith(skipped);
+    }
+    else EliminateOperand(node.a2);
+    EliminateOperand(node.a1);
+}
+
+void DeadCodeEliminator::Visit(ASTExpressionNegation& node)
+{
+    EliminateOperand(node.operand);
+}
+
+void DeadCodeEliminator::Visit(ASTExpressionInt2Float& node)
+{
+    EliminateOperand(node.operand);
+}
+
+void DeadCodeEliminator::Visit(ASTExpressionFloat2Int& node)
+{
+    EliminateOperand(node.operand);
+}
+
+void DeadCodeEliminator::Visit(ASTExpressionInt2Bool& node)
+{
+    EliminateOperand(node.operand);
+}
+
+void DeadCodeEliminator::Visit(ASTExpressionBool2Int& node)
+{
+    EliminateOperand(node.operand);
+}
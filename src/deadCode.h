@@ -0,0 +1,140 @@
+#pragma once
+
+#include "liveSet.h"
+#include "statement.h"
+#include "symbol.h"
+#include "visitor.h"
+#include <memory>
+#include <unordered_map>
+
+// Live status of functions by name.
+typedef std::unordered_map<Symbol, bool> LiveMap;
+
+// Removes branches and loop bodies whose condition is always false, and else branches whose condition is always true.
+class UnreachableCodeEliminator : public ASTMutator
+{
+public:
+
+    // Set whenever code is removed.
+    bool removed = false;
+
+    // Evaluate a condition to identify always-true and always-false conditions.
+    // expr: Condition to evaluate. May be null.
+    // Returns: 1 if always true, 0 if always false, and 2 if it can't be known.
+    static int EvaluateExpression(const ASTStatement* expr);
+
+    // Virtual functions. See base class for details.
+    void Visit(ASTStatementIf& node) override;
+    void Visit(ASTStatementWhile& node) override;
+    void Visit(ASTStatementFor& node) override;
+
+};
+
+// Removes assignments to variables that are never read afterwards. Statements are walked backwards from the end, keeping track of which variables are live.
+// Variables are numbered densely per function so live sets are bit vectors. Loops are walked until the variables live at their head stop changing.
+class DeadCodeEliminator : public ASTMutator
+{
+
+    // What is known about a loop so far. It is kept across walks of the code around the loop, so a nested loop does not have to start over every time an outer one is walked again.
+    struct LoopState
+    {
+
+        // Variables live after the loop that the head was last found for.
+        LiveSet liveOut;
+
+        // Variables live at the head of the loop, before the condition, for liveOut.
+        LiveSet head;
+
+        // If the head has been found at all yet.
+        bool solved = false;
+
+    };
+
+    // Number of each variable of the function being eliminated in. Variables not in here, like undeclared ones, are never live.
+    std::unordered_map<Symbol, uint32_t> indices;
+
+    // Live variables at the node being visited.
+    LiveSet* variables = nullptr;
+
+    // Live status of functions, shared by all functions of the AST.
+    LiveMap& functions;
+
+    // State of every loop walked so far.
+    std::unordered_map<const ASTStatement*, LoopState> loops;
+
+    // Whether to eliminate dead variables or just update live status.
+    bool eliminate = true;
+
+    // Whether the node being visited is a statement, whose value is dropped when it is removed, rather than an operand whose value stays.
+    bool statement = false;
+
+    // Set by visiting a node that is a dead assignment.
+    bool dead = false;
+
+    // Set once anything below the node being visited is removed. A loop with code removed from it forgets its trip count, which was found for the loop as it was.
+    bool changed = false;
+
+    // Removes unreachable code from control flow nodes before they are walked.
+    UnreachableCodeEliminator unreachable;
+
+    // Perform dead code elimination from designated node.
+    // node: Pointer to starting node. May be null.
+    // variables: Variables live after the node, which are updated to the ones live before it.
+    // eliminate: Whether to eliminate dead variables or just update live status.
+    // statement: Whether the node is a statement, so a dead assignment is removed with its value unless that has effects. Otherwise the value of a dead assignment replaces it, and what the value reads stays live.
+    // Returns: If the node is a dead assignment the caller should remove.
+    bool Eliminate(ASTStatement* node, LiveSet& variables, bool eliminate, bool statement = false);
+
+    // Remove unreachable code from a control flow node before walking it.
+    // node: Node to remove in.
+    template <typename T>
+    void RemoveUnreachable(T& node);
+
+    // Eliminate dead code below an operand, and replace the operand with its value if it is a dead assignment itself.
+    // operand: Operand to eliminate in.
+    template <typename T>
+    void EliminateOperand(std::unique_ptr<T>& operand);
+
+    // Find the variables live at the head of a loop, walking the loop until they stop changing. The result of the last call is reused if the variables live after the loop are the same.
+    // loop: Loop to solve.
+    // condition: Condition of the loop, checked at its head. May be null.
+    // walkIteration: Called with the variables live at the end of an iteration to update them to the ones live at its start, without eliminating anything.
+    // Returns: Variables live at the head of the loop.
+    template <typename WalkIteration>
+    const LiveSet& SolveLoop(const ASTStatement& loop, ASTStatement* condition, WalkIteration walkIteration);
+
+    // If the value of an assignment has effects and has to stay when the assignment is removed.
+    // value: Value assigned.
+    static bool HasEffects(const ASTStatement* value);
+
+    // Remove an assignment statement, keeping its value if that still has effects.
+    // node: Node of assignment to remove.
+    static void EliminateAssignmentStmt(std::unique_ptr<ASTStatement>& node);
+
+public:
+
+    // Create a new dead code eliminator.
+    // functions: Live status of functions to update.
+    explicit DeadCodeEliminator(LiveMap& functions) : functions(functions) {}
+
+    // Perform dead code elimination on the body of a function.
+    // function: Function to eliminate in. May be only declared.
+    void EliminateFunction(ASTFunction& function);
+
+    // Virtual functions. See base class for details.
+    void Visit(ASTStatementBlock& node) override;
+    void Visit(ASTStatementIf& node) override;
+    void Visit(ASTStatementWhile& node) override;
+    void Visit(ASTStatementFor& node) override;
+    void Visit(ASTStatementReturn& node) override;
+    void Visit(ASTExpressionVariable& node) override;
+    void Visit(ASTExpressionCall& node) override;
+    void Visit(ASTExpressionAssignment& node) override;
+    void Visit(ASTExpressionBinary& node) override;
+    void Visit(ASTExpressionNegation& node) override;
+    void Visit(ASTExpressionInt2Float& node) override;
+    void Visit(ASTExpressionFloat2Int& node) override;
+    void Visit(ASTExpressionInt2Bool& node) override;
+    void Visit(ASTExpressionBool2Int& node) override;
+
+};
@@ -1,5 +1,5 @@
 #include "ast.h"
-#include "expressions/addition.h"
+#include "expressions/arithmetic.h"
 #include "expressions/assignment.h"
 #include "expressions/call.h"
 #include "expressions/comparison.h"
@@ -21,12 +21,12 @@ int demo()
 
     // First, add a declaration to puts.
     ASTFunctionParameters putsParams;
-    putsParams.push_back(ASTFunctionParameter(VarTypeSimple::StringType.Copy(), "str"));
-    ast.AddFunction("printf", VarTypeSimple::IntType.Copy(), std::move(putsParams), true);
+    putsParams.push_back(ASTFunctionParameter(&VarTypeSimple::StringType, "str"));
+    ast.AddFunction("printf", &VarTypeSimple::IntType, std::move(putsParams), true);
 
     // Second, add the main method.
-    auto mainFunc = ast.AddFunction("main", VarTypeSimple::VoidType.Copy(), ASTFunctionParameters {});
-    mainFunc->AddStackVar(ASTFunctionParameter(VarTypeSimple::IntType.Copy(), "i")); // Iterator.
+    auto mainFunc = ast.AddFunction("main", &VarTypeSimple::VoidType, ASTFunctionParameters {});
+    mainFunc->AddStackVar(ASTFunctionParameter(&VarTypeSimple::IntType, "i")); // Iterator.
     auto statements = std::make_unique<ASTStatementBlock>();
 
     // Create a printf call to print Hello World.
@@ -133,13 +133,15 @@ int demo()
     // Define the main function.
     mainFunc->Define(std::move(statements));
 
-    // Finally, compile and write LLVM assembly.
+    // Finally, type check, compile, and write LLVM assembly.
+    ast.SemanticAnalysisPass();
     ast.Compile();
     ast.WriteLLVMAssemblyToFile("testMod.ll");
     ast.WriteLLVMBitcodeToFile("testMod.bc");
 
     // Print out AST tree and return.
-    std::cout << ast.ToString() << std::endl;
+    ast.Print(std::cout);
+    std::cout << std::endl;
     return 0;
 
 }
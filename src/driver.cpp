@@ -0,0 +1,137 @@
+#include "driver.h"
+
+#include "parallel.h"
+
+#include <thread>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/raw_ostream.h>
+
+Driver::Driver(unsigned threads, bool parseOnly) : threads(threads), parseOnly(parseOnly)
+{
+
+    // Use every hardware thread by default.
+    if (this->threads == 0) this->threads = std::max(1u, std::thread::hardware_concurrency());
+
+}
+
+void Driver::AddFile(const std::string& inputFile)
+{
+    units.emplace_back();
+    units.back().inputFile = inputFile;
+}
+
+void Driver::AddBinaryAstFile(const std::string& inputFile)
+{
+    units.emplace_back();
+    units.back().inputFile = inputFile;
+    units.back().binaryAst = true;
+}
+
+void Driver::AddSource(const std::string& name, std::string_view source)
+{
+    units.emplace_back();
+    units.back().inputFile = name;
+    units.back().source = source;
+}
+
+void Driver::CompileUnitJob(CompileUnit& unit)
+{
+    try
+    {
+
+        // Fetch input. Files are memory-mapped, standard in has to be read in all at once.
+        unit.context = std::make_unique<ParseContext>("TestMod");
+        if (unit.source) unit.context->source.Copy(*unit.source);
+        else if (unit.inputFile != "")
+        {
+            if (!unit.context->source.Map(unit.inputFile))
+            {
+                unit.error = "Could not open input file " + unit.inputFile;
+                return;
+            }
+        }
+        else unit.context->source.Read(stdin);
+
+        // Binary ASTs are read straight from the mapped file, everything else has to be parsed.
+        if (unit.binaryAst) unit.context->ast.ReadBinary(std::string_view(unit.context->source.Data(), unit.context->source.Size()));
+        else if (!unit.context->Parse(units.size() == 1 ? threads : 1)) // A lone unit can use the whole pool to parse.
+        {
+            unit.error = "Irrecoverable error state, aborting";
+            return;
+        }
+        if (parseOnly) return;
+
+        // Optimize and compile.
+        unit.context->ast.DeadCodeEliminationPass();
+        unit.context->ast.SemanticAnalysisPass();
+        unit.context->ast.Compile();
+
+        // Linking happens in another context, so serialize the module to carry it over.
+        if (units.size() > 1) unit.context->ast.WriteLLVMBitcodeToBuffer(unit.bitcode);
+
+    }
+    catch (const std::exception& e)
+    {
+        unit.error = e.what();
+    }
+}
+
+bool Driver::Link()
+{
+    linkContext = std::make_unique<llvm::LLVMContext>();
+    linked = std::make_unique<llvm::Module>("TestMod", *linkContext);
+    llvm::Linker linker(*linked);
+    for (auto& unit : units)
+    {
+        auto mod = llvm::parseBitcodeFile(llvm::MemoryBufferRef(llvm::StringRef(unit.bitcode.data(), unit.bitcode.size()), unit.inputFile), *linkContext);
+        if (!mod)
+        {
+            diagnostics += "ERROR: Could not load module " + unit.inputFile + ": " + llvm::toString(mod.takeError()) + "\n";
+            return false;
+        }
+        if (linker.linkInModule(std::move(*mod))) // Returns true on error, which the linker already reported.
+        {
+            diagnostics += "ERROR: Could not link module " + unit.inputFile + "!\n";
+            return false;
+        }
+        unit.bitcode.clear(); // No longer needed.
+    }
+    return true;
+}
+
+bool Driver::Run()
+{
+
+    // Compile every unit on the worker pool.
+    RunParallel(units.size(), threads, [&](size_t i) { CompileUnitJob(units[i]); });
+
+    // Report messages and errors in input order.
+    bool success = true;
+    for (auto& unit : units)
+    {
+        if (unit.context) diagnostics += unit.context->ast.diagnostics;
+        if (unit.error == "") continue;
+        diagnostics += (unit.inputFile == "" ? "" : unit.inputFile + ": ") + unit.error + "\n";
+        success = false;
+    }
+    if (!success) return false;
+
+    // A single unit needs no linking, and neither do units that were only parsed.
+    return units.size() == 1 || parseOnly || Link();
+
+}
+
+void Driver::WriteLLVMAssembly(llvm::raw_ostream& out)
+{
+    if (!linked) return units[0].context->ast.WriteLLVMAssembly(out);
+    linked->print(out, nullptr);
+}
+
+void Driver::WriteLLVMBitcode(llvm::raw_ostream& out)
+{
+    if (!linked) return units[0].context->ast.WriteLLVMBitcode(out);
+    llvm::WriteBitcodeToFile(*linked, out);
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "frontend/parseContext.h"
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/raw_ostream.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A single input file and everything produced from it.
+struct CompileUnit
+{
+
+    // File to read from, or the name of a source given in memory. Nothing for standard in.
+    std::string inputFile;
+
+    // If the input file is a binary AST to read instead of source to parse.
+    bool binaryAst = false;
+
+    // Source given in memory instead of a file. It is copied when the unit is compiled, so it must stay alive until the driver has run.
+    std::optional<std::string_view> source;
+
+    // Parse context that owns the unit's input and AST.
+    std::unique_ptr<ParseContext> context;
+
+    // Compiled bitcode of the unit, used to move the module into the linking context.
+    llvm::SmallVector<char, 0> bitcode;
+
+    // Error message if the unit failed. Empty on success.
+    std::string error;
+
+};
+
+// Compiles many input files at once and links them into a single module.
+// Each unit is parsed, optimized, and compiled on a pool of worker threads with its own LLVM context and module.
+class Driver
+{
+
+    // Units to compile, in the order they were given.
+    std::vector<CompileUnit> units;
+
+    // Number of worker threads to use.
+    unsigned threads;
+
+    // If to stop after parsing, leaving every AST as the front end made it.
+    bool parseOnly;
+
+    // Context of the linked module. Modules from different contexts can't be linked, so each unit is moved in here through its bitcode.
+    // Only made when there is something to link, so compiling a single unit doesn't pay for it.
+    std::unique_ptr<llvm::LLVMContext> linkContext;
+
+    // Result of linking all units. Only used if there is more than one unit.
+    std::unique_ptr<llvm::Module> linked;
+
+    // Diagnostics of every unit in input order, followed by any linking errors.
+    std::string diagnostics;
+
+    // Parse, optimize, and compile a single unit. Errors are stored in the unit.
+    // unit: Unit to compile.
+    void CompileUnitJob(CompileUnit& unit);
+
+    // Link all compiled units into the linked module.
+    // Returns: If linking succeeded.
+    bool Link();
+
+public:
+
+    // Create a new driver with no units.
+    // threads: Number of worker threads. 0 uses one per hardware thread.
+    // parseOnly: If to stop after parsing, without optimizing, compiling, or linking.
+    Driver(unsigned threads = 0, bool parseOnly = false);
+
+    // Add a file to compile.
+    // inputFile: File to read from. Nothing for standard in.
+    void AddFile(const std::string& inputFile);
+
+    // Add a binary AST file to compile, which is read instead of parsed. See binaryAst.h.
+    // inputFile: File to read from.
+    void AddBinaryAstFile(const std::string& inputFile);
+
+    // Add source in memory to compile.
+    // name: Name to report errors under.
+    // source: Source to compile. It must stay alive until the driver has run.
+    void AddSource(const std::string& name, std::string_view source);
+
+    // Compile and link all units.
+    // Returns: If everything succeeded. Either way, messages are in the diagnostics.
+    bool Run();
+
+    // Get the errors, warnings, and info messages from running.
+    const std::string& Diagnostics() const { return diagnostics; }
+
+    // Get the units in input order. Their ASTs can be printed after running.
+    const std::vector<CompileUnit>& Units() const { return units; }
+
+    // Write LLVM assembly of the linked module to a stream. Must be done after running.
+    // out: Stream to write to.
+    void WriteLLVMAssembly(llvm::raw_ostream& out);
+
+    // Write LLVM bitcode of the linked module to a stream. Must be done after running.
+    // out: Stream to write to.
+    void WriteLLVMBitcode(llvm::raw_ostream& out);
+
+};
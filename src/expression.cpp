@@ -4,21 +4,21 @@
 #include "expressions/int2Bool.h"
 #include "expressions/int2Float.h"
 
-llvm::Value* ASTExpression::CompileRValue(llvm::IRBuilder<>& builder, ASTFunction& func)
+llvm::Value* ASTExpression::CompileRValue(llvm::IRBuilder<>& builder, ASTFunction& func) const
 {
     llvm::Value* raw = Compile(builder, func); // First get the naturally compiled value.
     if (IsLValue(func)) // If the value is an L-Value, we need to load it.
     {
-        return builder.CreateLoad(ReturnType(func)->GetLLVMType(builder.getContext()), raw); // Use the return type from this expression to load the needed value.
+        return builder.CreateLoad(type->GetLLVMType(builder.getContext()), raw); // Use the return type from this expression to load the needed value.
     }
     else return raw; // It's already an R-Value.
 }
 
-void ASTExpression::ImplicitCast(ASTFunction& func, std::unique_ptr<ASTExpression>& srcExpression, VarType* destType)
+void ASTExpression::ImplicitCast(ASTFunction& func, std::unique_ptr<ASTExpression>& srcExpression, const VarType* destType)
 {
 
     // If the types are equal, nothing needs to be done.
-    auto srcType = srcExpression->ReturnType(func);
+    auto srcType = srcExpression->type;
     if (srcType->Equals(destType)) return;
 
     // Destination type is a boolean.
@@ -28,12 +28,14 @@ void ASTExpression::ImplicitCast(ASTFunction& func, std::unique_ptr<ASTExpressio
         {
             auto tmp = std::move(srcExpression);
             srcExpression = std::make_unique<ASTExpressionFloat2Int>(std::move(tmp));
-            srcType = srcExpression->ReturnType(func);
+            srcExpression->TypeCheck(func);
+            srcType = srcExpression->type;
         }
         if (srcType->Equals(&VarTypeSimple::IntType)) // Cast to bool now.
         {
             auto tmp = std::move(srcExpression);
             srcExpression = std::make_unique<ASTExpressionInt2Bool>(std::move(tmp));
+            srcExpression->TypeCheck(func);
             return; // Finished successfully.
         }
     }
@@ -45,12 +47,14 @@ void ASTExpression::ImplicitCast(ASTFunction& func, std::unique_ptr<ASTExpressio
         {
             auto tmp = std::move(srcExpression);
             srcExpression = std::make_unique<ASTExpressionFloat2Int>(std::move(tmp));
+            srcExpression->TypeCheck(func);
             return;
         }
         if (srcType->Equals(&VarTypeSimple::BoolType))
         {
             auto tmp = std::move(srcExpression);
             srcExpression = std::make_unique<ASTExpressionBool2Int>(std::move(tmp));
+            srcExpression->TypeCheck(func);
             return;
         }
     }
@@ -62,12 +66,14 @@ void ASTExpression::ImplicitCast(ASTFunction& func, std::unique_ptr<ASTExpressio
         {
             auto tmp = std::move(srcExpression);
             srcExpression = std::make_unique<ASTExpressionBool2Int>(std::move(tmp));
-            srcType = srcExpression->ReturnType(func);
+            srcExpression->TypeCheck(func);
+            srcType = srcExpression->type;
         }
         if (srcType->Equals(&VarTypeSimple::IntType)) // Cast to float now.
         {
             auto tmp = std::move(srcExpression);
             srcExpression = std::make_unique<ASTExpressionInt2Float>(std::move(tmp));
+            srcExpression->TypeCheck(func);
             return; // Finished successfully.
         }
     }
@@ -77,12 +83,12 @@ void ASTExpression::ImplicitCast(ASTFunction& func, std::unique_ptr<ASTExpressio
 
 }
 
-bool ASTExpression::CoerceMathTypes(ASTFunction& func, std::unique_ptr<ASTExpression>& a1, std::unique_ptr<ASTExpression>& a2, VarTypeSimple*& outCoercedType)
+bool ASTExpression::CoerceMathTypes(ASTFunction& func, std::unique_ptr<ASTExpression>& a1, std::unique_ptr<ASTExpression>& a2, const VarType*& outCoercedType)
 {
 
     // Gather return types.
-    auto r1 = a1->ReturnType(func);
-    auto r2 = a2->ReturnType(func);
+    auto r1 = a1->type;
+    auto r2 = a2->type;
 
     // Make sure r1 is either a float or int.
     bool r1Float = r1->Equals(&VarTypeSimple::FloatType);
@@ -108,6 +114,7 @@ bool ASTExpression::CoerceMathTypes(ASTFunction& func, std::unique_ptr<ASTExpres
             outCoercedType = &VarTypeSimple::FloatType;
             auto tmp = std::move(a2);
             a2 = std::make_unique<ASTExpressionInt2Float>(std::move(tmp));
+            a2->TypeCheck(func);
         }
 
     }
@@ -120,6 +127,7 @@ bool ASTExpression::CoerceMathTypes(ASTFunction& func, std::unique_ptr<ASTExpres
             outCoercedType = &VarTypeSimple::FloatType;
             auto tmp = std::move(a1);
             a1 = std::make_unique<ASTExpressionInt2Float>(std::move(tmp));
+            a1->TypeCheck(func);
         }
 
         // Both are ints. No casting needed.
@@ -133,30 +141,32 @@ bool ASTExpression::CoerceMathTypes(ASTFunction& func, std::unique_ptr<ASTExpres
 
 }
 
-bool ASTExpression::CoerceTypes(ASTFunction& func, std::unique_ptr<ASTExpression>& a1, std::unique_ptr<ASTExpression>& a2, VarTypeSimple*& outCoercedType)
+bool ASTExpression::CoerceTypes(ASTFunction& func, std::unique_ptr<ASTExpression>& a1, std::unique_ptr<ASTExpression>& a2, const VarType*& outCoercedType)
 {
 
     // All we really need to do is convert bool to int first if needed then coerce the math types.
-    if (a1->ReturnType(func)->Equals(&VarTypeSimple::BoolType))
+    if (a1->type->Equals(&VarTypeSimple::BoolType))
     {
         auto tmp = std::move(a1);
         a1 = std::make_unique<ASTExpressionBool2Int>(std::move(tmp));
+        a1->TypeCheck(func);
     }
-    if (a2->ReturnType(func)->Equals(&VarTypeSimple::BoolType))
+    if (a2->type->Equals(&VarTypeSimple::BoolType))
     {
         auto tmp = std::move(a2);
         a2 = std::make_unique<ASTExpressionBool2Int>(std::move(tmp));
+        a2->TypeCheck(func);
     }
     return CoerceMathTypes(func, a1, a2, outCoercedType);
 
 }
 
-std::unique_ptr<VarType> ASTExpression::StatementReturnType(ASTFunction& func)
+void ASTExpression::TypeCheck(ASTFunction& func)
 {
-    return nullptr; // Expression returns nothing statement wise.
+    type = ComputeReturnType(func);
 }
 
-void ASTExpression::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func)
+void ASTExpression::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) const
 {
 
     // We can compile the expression itself, we just don't return anything since this is an expression and not a return statement.
@@ -2,22 +2,20 @@
 
 #include "../function.h"
 
-std::unique_ptr<VarType> ASTExpressionAnd::ReturnType(ASTFunction& func)
-{
-    return VarTypeSimple::BoolType.Copy(); // a && b is always a boolean.
-}
-
-bool ASTExpressionAnd::IsLValue(ASTFunction& func)
-{
-    return false; // && operator works on two R-Values to produce an R-Value.
-}
-
-llvm::Value* ASTExpressionAnd::Compile(llvm::IRBuilder<>& builder, ASTFunction& func)
+const VarType* ASTExpressionAnd::ComputeReturnType(ASTFunction& func)
 {
 
     // Make sure to cast both sides as booleans first.
+    a1->TypeCheck(func);
+    a2->TypeCheck(func);
     ASTExpression::ImplicitCast(func, a1, &VarTypeSimple::BoolType);
     ASTExpression::ImplicitCast(func, a2, &VarTypeSimple::BoolType);
+    return &VarTypeSimple::BoolType; // a && b is always a boolean.
+
+}
+
+llvm::Value* ASTExpressionAnd::Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const
+{
 
     // Create blocks. Check right is if left is true, and we need to check the right one too. Continue block happens if false.
     auto* funcVal = (llvm::Function*)func.GetVariableValue(func.name);
@@ -33,6 +31,7 @@ llvm::Value* ASTExpressionAnd::Compile(llvm::IRBuilder<>& builder, ASTFunction&
     builder.SetInsertPoint(checkRight);
     llvm::Value* rightVal = a2->CompileRValue(builder, func);
     llvm::BasicBlock* lastBlockRight = builder.GetInsertBlock(); // In case the block has changed, fix it.
+    builder.CreateBr(cont);
 
     // Tell LLVM that it should either select the left value or the right one depending on where we came from.
     builder.SetInsertPoint(cont);
@@ -41,12 +40,4 @@ llvm::Value* ASTExpressionAnd::Compile(llvm::IRBuilder<>& builder, ASTFunction&
     res->addIncoming(rightVal, lastBlockRight);
     return res;
 
-}
-
-std::string ASTExpressionAnd::ToString(const std::string& prefix)
-{
-    std::string ret = "(&&)\n";
-    ret += prefix + "├──" + a1->ToString(prefix + "│  ");
-    ret += prefix + "└──" + a2->ToString(prefix + "   ");
-    return ret;
 }
\ No newline at end of file
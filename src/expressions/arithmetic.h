@@ -0,0 +1,124 @@
+#pragma once
+
+#include "binary.h"
+#include <climits>
+
+/*
+    Addition, subtraction, multiplication, and division only differ in the instructions they compile to and how they fold constants.
+    So they are a single node template, with an operator traits struct saying what is different about each one.
+    A traits struct has:
+        KIND: Kind of node.
+        NAME: Name of the operation used in errors.
+        SYMBOL: Symbol of the operator.
+        INT_OP, FLOAT_OP: LLVM instruction for int and float operands.
+        CanFold(a, b): If two int constants can be folded at compile time, which is not the case when the instruction has undefined behavior.
+        Fold(a, b): Result of the operation on two constants, int or float. Ints wrap around like the LLVM instructions do.
+*/
+
+// Traits of addition.
+struct ASTAdditionTraits
+{
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Addition;
+    static constexpr const char* NAME = "addition";
+    static constexpr const char* SYMBOL = "+";
+    static constexpr llvm::Instruction::BinaryOps INT_OP = llvm::Instruction::Add;
+    static constexpr llvm::Instruction::BinaryOps FLOAT_OP = llvm::Instruction::FAdd;
+    static constexpr bool CanFold(int a, int b) { return true; }
+    static constexpr int Fold(int a, int b) { return (int)((unsigned)a + (unsigned)b); }
+    static constexpr double Fold(double a, double b) { return a + b; }
+};
+
+// Traits of subtraction.
+struct ASTSubtractionTraits
+{
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Subtraction;
+    static constexpr const char* NAME = "subtraction";
+    static constexpr const char* SYMBOL = "-";
+    static constexpr llvm::Instruction::BinaryOps INT_OP = llvm::Instruction::Sub;
+    static constexpr llvm::Instruction::BinaryOps FLOAT_OP = llvm::Instruction::FSub;
+    static constexpr bool CanFold(int a, int b) { return true; }
+    static constexpr int Fold(int a, int b) { return (int)((unsigned)a - (unsigned)b); }
+    static constexpr double Fold(double a, double b) { return a - b; }
+};
+
+// Traits of multiplication.
+struct ASTMultiplicationTraits
+{
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Multiplication;
+    static constexpr const char* NAME = "multiplication";
+    static constexpr const char* SYMBOL = "*";
+    static constexpr llvm::Instruction::BinaryOps INT_OP = llvm::Instruction::Mul;
+    static constexpr llvm::Instruction::BinaryOps FLOAT_OP = llvm::Instruction::FMul;
+    static constexpr bool CanFold(int a, int b) { return true; }
+    static constexpr int Fold(int a, int b) { return (int)((unsigned)a * (unsigned)b); }
+    static constexpr double Fold(double a, double b) { return a * b; }
+};
+
+// Traits of division.
+struct ASTDivisionTraits
+{
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Division;
+    static constexpr const char* NAME = "division";
+    static constexpr const char* SYMBOL = "/";
+    static constexpr llvm::Instruction::BinaryOps INT_OP = llvm::Instruction::SDiv;
+    static constexpr llvm::Instruction::BinaryOps FLOAT_OP = llvm::Instruction::FDiv;
+    static constexpr bool CanFold(int a, int b) { return b != 0 && !(a == INT_MIN && b == -1); } // Both are undefined for sdiv.
+    static constexpr int Fold(int a, int b) { return a / b; }
+    static constexpr double Fold(double a, double b) { return a / b; }
+};
+
+// An arithmetic expression on two ints or floats. See above for the traits.
+template <typename Traits>
+class ASTExpressionArithmetic : public ASTExpressionBinary
+{
+
+public:
+
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = Traits::KIND;
+
+    // Create a new arithmetic expression.
+    // a1: Left operand.
+    // a2: Right operand.
+    ASTExpressionArithmetic(std::unique_ptr<ASTExpression> a1, std::unique_ptr<ASTExpression> a2) : ASTExpressionBinary(KIND, std::move(a1), std::move(a2)) {}
+
+    // Create a new arithmetic expression.
+    // a1: Left operand.
+    // a2: Right operand.
+    static auto Create(std::unique_ptr<ASTExpression> a1, std::unique_ptr<ASTExpression> a2)
+    {
+        return std::make_unique<ASTExpressionArithmetic>(std::move(a1), std::move(a2));
+    }
+
+    // Virtual functions. See base class for details.
+    const char* Symbol() const override { return Traits::SYMBOL; }
+
+    const VarType* ComputeReturnType(ASTFunction& func) override
+    {
+        a1->TypeCheck(func);
+        a2->TypeCheck(func);
+        const VarType* returnType;
+        if (!ASTExpression::CoerceMathTypes(func, a1, a2, returnType)) // This will force our arguments to be the same type and outputs which one it is.
+            throw std::runtime_error(std::string("ERROR: Can not coerce types in ") + Traits::NAME + " expression! Are they both either ints or floats?");
+        return returnType;
+    }
+
+    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const override
+    {
+        // Compile the values as needed. Remember, we can only do operations on R-Values.
+        auto retType = ReturnType();
+        if (retType->Equals(&VarTypeSimple::IntType)) // Do the integer operation since we return an int.
+            return builder.CreateBinOp(Traits::INT_OP, a1->CompileRValue(builder, func), a2->CompileRValue(builder, func));
+        else if (retType->Equals(&VarTypeSimple::FloatType)) // Do the floating point operation since we return a float.
+            return builder.CreateBinOp(Traits::FLOAT_OP, a1->CompileRValue(builder, func), a2->CompileRValue(builder, func));
+        else // Call to return type should make this impossible, but best to keep it here just in case of a bug.
+            throw std::runtime_error(std::string("ERROR: Can not perform ") + Traits::NAME + "! Are both inputs either ints or floats?");
+    }
+
+};
+
+// The arithmetic expressions.
+typedef ASTExpressionArithmetic<ASTAdditionTraits> ASTExpressionAddition;
+typedef ASTExpressionArithmetic<ASTSubtractionTraits> ASTExpressionSubtraction;
+typedef ASTExpressionArithmetic<ASTMultiplicationTraits> ASTExpressionMultiplication;
+typedef ASTExpressionArithmetic<ASTDivisionTraits> ASTExpressionDivision;
\ No newline at end of file
@@ -7,6 +7,10 @@ class ASTExpressionAssignment: public ASTExpression
 {
 
 public:
+
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Assignment;
+
     // Operands to work with.
     std::unique_ptr<ASTExpression> left;
     std::unique_ptr<ASTExpression> right;
@@ -14,7 +18,7 @@ public:
     // Create a new addition expression.
     // left: Value to store an expression into (has to be an L-Value).
     // right: What to store into the value on the left.
-    ASTExpressionAssignment(std::unique_ptr<ASTExpression> left, std::unique_ptr<ASTExpression> right) : left(std::move(left)), right(std::move(right)) {}
+    ASTExpressionAssignment(std::unique_ptr<ASTExpression> left, std::unique_ptr<ASTExpression> right) : ASTExpression(KIND), left(std::move(left)), right(std::move(right)) {}
 
     // Create a new addition expression.
     // left: Value to store an expression into (has to be an L-Value).
@@ -25,8 +29,9 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> ReturnType(ASTFunction& func) override;
-    bool IsLValue(ASTFunction& func) override;
-    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    const VarType* ComputeReturnType(ASTFunction& func) override;
+    bool IsLValue(ASTFunction& func) const override;
+    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 };
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../expression.h"
+
+// An expression with a left and right operand, like arithmetic, comparisons, and logic. Passes that treat every binary operator the same can handle them all through this class.
+class ASTExpressionBinary : public ASTExpression
+{
+
+public:
+
+    // Operands to work with.
+    std::unique_ptr<ASTExpression> a1;
+    std::unique_ptr<ASTExpression> a2;
+
+    // Create a new binary expression.
+    // kind: What kind of node this is.
+    // a1: Left operand.
+    // a2: Right operand.
+    ASTExpressionBinary(ASTNodeKind kind, std::unique_ptr<ASTExpression> a1, std::unique_ptr<ASTExpression> a2) : ASTExpression(kind), a1(std::move(a1)), a2(std::move(a2)) {}
+
+    // Get the symbol of the operator, for printing.
+    // Returns: The symbol, like "+".
+    virtual const char* Symbol() const = 0;
+
+    // Binary operators always work on two R-Values to produce an R-Value.
+    bool IsLValue(ASTFunction& func) const override { return false; }
+
+    // Virtual functions. See base class for details.
+    void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
+
+};
\ No newline at end of file
@@ -8,12 +8,15 @@ class ASTExpressionBool : public ASTExpression
 
 public:
 
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Bool;
+
     // Constant bool value.
     bool value;
     
     // Create a new constant bool expression.
     // val: Constant bool value to create.
-    explicit ASTExpressionBool(bool val) : value(val) {}
+    explicit ASTExpressionBool(bool val) : ASTExpression(KIND), value(val) {}
 
     // Create a new constant bool expression.
     // val: Constant bool value to create.
@@ -23,8 +26,9 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> ReturnType(ASTFunction& func) override;
-    bool IsLValue(ASTFunction& func) override;
-    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    const VarType* ComputeReturnType(ASTFunction& func) override;
+    bool IsLValue(ASTFunction& func) const override;
+    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 };
\ No newline at end of file
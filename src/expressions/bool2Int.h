@@ -7,12 +7,15 @@ class ASTExpressionBool2Int : public ASTExpression
 {
 public:
 
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Bool2Int;
+
     // Operand to work on.
     std::unique_ptr<ASTExpression> operand;
 
     // Create a bool to int conversion.
     // operand: Expression to convert to an int. Make sure it is a bool type, or else this will fail.
-    explicit ASTExpressionBool2Int(std::unique_ptr<ASTExpression> operand) : operand(std::move(operand)) {}
+    explicit ASTExpressionBool2Int(std::unique_ptr<ASTExpression> operand) : ASTExpression(KIND), operand(std::move(operand)) {}
 
     // Create a bool to int conversion.
     // operand: Expression to convert to an int. Make sure it is a bool type, or else this will fail.
@@ -22,8 +25,9 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> ReturnType(ASTFunction& func) override;
-    bool IsLValue(ASTFunction& func) override;
-    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    const VarType* ComputeReturnType(ASTFunction& func) override;
+    bool IsLValue(ASTFunction& func) const override;
+    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 };
\ No newline at end of file
@@ -9,6 +9,9 @@ class ASTExpressionCall : public ASTExpression
 
 public:
 
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Call;
+
     // Value to call.
     std::unique_ptr<ASTExpression> callee;
 
@@ -18,7 +21,7 @@ public:
     // Create a new call expression.
     // callee: The expression to call.
     // arguments: Arguments to pass to the call.
-    ASTExpressionCall(std::unique_ptr<ASTExpression> callee, std::vector<std::unique_ptr<ASTExpression>> arguments) : callee(std::move(callee)), arguments(std::move(arguments)) {}
+    ASTExpressionCall(std::unique_ptr<ASTExpression> callee, std::vector<std::unique_ptr<ASTExpression>> arguments) : ASTExpression(KIND), callee(std::move(callee)), arguments(std::move(arguments)) {}
 
     // Create a new call expression.
     // callee: The expression to call.
@@ -29,9 +32,10 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> ReturnType(ASTFunction& func) override;
-    bool IsLValue(ASTFunction& func) override;
-    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    const VarType* ComputeReturnType(ASTFunction& func) override;
+    bool IsLValue(ASTFunction& func) const override;
+    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 
 };
\ No newline at end of file
@@ -1,20 +1,32 @@
 #include "comparison.h"
 
-std::unique_ptr<VarType> ASTExpressionComparison::ReturnType(ASTFunction& func)
+const VarType* ASTExpressionComparison::ComputeReturnType(ASTFunction& func)
 {
-    return VarTypeSimple::BoolType.Copy();
+    a1->TypeCheck(func);
+    a2->TypeCheck(func);
+    const VarType* operandType;
+    if (!ASTExpression::CoerceTypes(func, a1, a2, operandType)) // This will force our arguments to be the same type and outputs which one it is.
+        throw std::runtime_error("ERROR: Can not coerce types in comparison expression! Are they all booleans, ints, and floats?");
+    return &VarTypeSimple::BoolType;
 }
 
-bool ASTExpressionComparison::IsLValue(ASTFunction& func)
+const char* ASTExpressionComparison::Symbol() const
 {
-    return false; // If we are adding values together, they must be usable R-Values. Adding these together just results in an R-Value.
+    switch (type)
+    {
+        case Equal: return "=";
+        case NotEqual: return "!=";
+        case LessThan: return "<";
+        case LessThanOrEqual: return "<=";
+        case GreaterThan: return ">";
+        case GreaterThanOrEqual: return ">=";
+    }
+    return "";
 }
 
-llvm::Value* ASTExpressionComparison::Compile(llvm::IRBuilder<>& builder, ASTFunction& func)
+llvm::Value* ASTExpressionComparison::Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const
 {
-    VarTypeSimple* returnType;
-    if (!ASTExpression::CoerceTypes(func, a1, a2, returnType)) // This will force our arguments to be the same type and outputs which one it is.
-            throw std::runtime_error("ERROR: Can not coerce types in comparison expression! Are they all booleans, ints, and floats?");
+    const VarType* returnType = a1->ReturnType(); // Type checking coerced both operands to the same type.
 
     // Get values. Operations only work on R-Values.
     auto a1Val = a1->CompileRValue(builder, func);
@@ -51,22 +63,4 @@ llvm::Value* ASTExpressionComparison::Compile(llvm::IRBuilder<>& builder, ASTFun
     // How did we get here?
     throw std::runtime_error("ERROR: Did not return value from comparison. Unsuccessful coercion of values or invalid comparison type!");
     
-}
-
-std::string ASTExpressionComparison::ToString(const std::string& prefix)
-{
-    std::string op = "";
-    switch (type)
-    {
-        case Equal: op = "="; break;
-        case NotEqual: op = "!="; break;
-        case LessThan: op = "<"; break;
-        case LessThanOrEqual: op = "<="; break;
-        case GreaterThan: op = ">"; break;
-        case GreaterThanOrEqual: op = ">="; break;
-    }
-    std::string ret = "(" + op + ")\n";
-    ret += prefix + "├──" + a1->ToString(prefix + "│  ");
-    ret += prefix + "└──" + a2->ToString(prefix + "   ");
-    return ret;
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "../expression.h"
+#include "binary.h"
 
 // Comparison types.
 enum ASTExpressionComparisonType
@@ -14,22 +14,21 @@ enum ASTExpressionComparisonType
 };
 
 // An expression that is a comparison.
-class ASTExpressionComparison : public ASTExpression
+class ASTExpressionComparison : public ASTExpressionBinary
 {
 public:
 
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Comparison;
+
     // Type of comparison to do.
     ASTExpressionComparisonType type;
 
-    // Operands to work with.
-    std::unique_ptr<ASTExpression> a1;
-    std::unique_ptr<ASTExpression> a2;
-    
     // Create a new comparison expression.
     // type: Type of comparison to do.
     // a1: Left operand.
     // a2: Right operand.
-    ASTExpressionComparison(ASTExpressionComparisonType type, std::unique_ptr<ASTExpression> a1, std::unique_ptr<ASTExpression> a2) : type(type), a1(std::move(a1)), a2(std::move(a2)) {}
+    ASTExpressionComparison(ASTExpressionComparisonType type, std::unique_ptr<ASTExpression> a1, std::unique_ptr<ASTExpression> a2) : ASTExpressionBinary(KIND, std::move(a1), std::move(a2)), type(type) {}
 
     // Create a new comparison expression.
     // type: Type of comparison to do.
@@ -41,8 +40,7 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> ReturnType(ASTFunction& func) override;
-    bool IsLValue(ASTFunction& func) override;
-    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    const char* Symbol() const override;
+    const VarType* ComputeReturnType(ASTFunction& func) override;
+    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const override;
 };
\ No newline at end of file
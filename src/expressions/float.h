@@ -7,12 +7,16 @@ class ASTExpressionFloat : public ASTExpression
 {
 
 public:
+
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Float;
+
     // Constant float value.
     double value;
     
     // Create a new constant float expression.
     // val: Constant float value to create.
-    explicit ASTExpressionFloat(double val) : value(val) {}
+    explicit ASTExpressionFloat(double val) : ASTExpression(KIND), value(val) {}
 
     // Create a new constant float expression.
     // val: Constant float value to create.
@@ -22,8 +26,9 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> ReturnType(ASTFunction& func) override;
-    bool IsLValue(ASTFunction& func) override;
-    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    const VarType* ComputeReturnType(ASTFunction& func) override;
+    bool IsLValue(ASTFunction& func) const override;
+    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 };
\ No newline at end of file
@@ -8,12 +8,15 @@ class ASTExpressionInt2Float : public ASTExpression
 
 public:
 
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Int2Float;
+
     // Operand to work on.
     std::unique_ptr<ASTExpression> operand;
     
     // Create a new integer to float conversion.
     // operand: Expression to convert to a float. Make sure it is an int type, or else this will fail.
-    explicit ASTExpressionInt2Float(std::unique_ptr<ASTExpression> operand) : operand(std::move(operand)) {}
+    explicit ASTExpressionInt2Float(std::unique_ptr<ASTExpression> operand) : ASTExpression(KIND), operand(std::move(operand)) {}
 
     // Create a new integer to float conversion.
     // operand: Expression to convert to a float. Make sure it is an int type, or else this will fail.
@@ -23,8 +26,9 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> ReturnType(ASTFunction& func) override;
-    bool IsLValue(ASTFunction& func) override;
-    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    const VarType* ComputeReturnType(ASTFunction& func) override;
+    bool IsLValue(ASTFunction& func) const override;
+    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 };
\ No newline at end of file
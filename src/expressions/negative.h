@@ -8,15 +8,15 @@ class ASTExpressionNegation : public ASTExpression
 
 public:
 
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Negation;
+
     // Operand to work with.
     std::unique_ptr<ASTExpression> operand;
 
-    // Return type to cache.
-    VarTypeSimple* returnType = nullptr;
-    
     // Create a new negation expression.
     // operand: Expression of the negation statement.
-    ASTExpressionNegation(std::unique_ptr<ASTExpression> operand) : operand(std::move(operand)) {}
+    ASTExpressionNegation(std::unique_ptr<ASTExpression> operand) : ASTExpression(KIND), operand(std::move(operand)) {}
 
     // Create a new negation expression.
     // operand: Expression of the negation statement.
@@ -26,8 +26,9 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> ReturnType(ASTFunction& func) override;
-    bool IsLValue(ASTFunction& func) override;
-    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    const VarType* ComputeReturnType(ASTFunction& func) override;
+    bool IsLValue(ASTFunction& func) const override;
+    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 };
\ No newline at end of file
@@ -2,22 +2,20 @@
 
 #include "../function.h"
 
-std::unique_ptr<VarType> ASTExpressionOr::ReturnType(ASTFunction& func)
-{
-    return VarTypeSimple::BoolType.Copy(); // a || b is always a boolean.
-}
-
-bool ASTExpressionOr::IsLValue(ASTFunction& func)
-{
-    return false; // || operator works on two R-Values to produce an R-Value.
-}
-
-llvm::Value* ASTExpressionOr::Compile(llvm::IRBuilder<>& builder, ASTFunction& func) // Hm, this isn't the most efficient approach. I can think of a much easier way...
+const VarType* ASTExpressionOr::ComputeReturnType(ASTFunction& func)
 {
 
     // Make sure to cast both sides as booleans first.
+    a1->TypeCheck(func);
+    a2->TypeCheck(func);
     ASTExpression::ImplicitCast(func, a1, &VarTypeSimple::BoolType);
     ASTExpression::ImplicitCast(func, a2, &VarTypeSimple::BoolType);
+    return &VarTypeSimple::BoolType; // a || b is always a boolean.
+
+}
+
+llvm::Value* ASTExpressionOr::Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const // Hm, this isn't the most efficient approach. I can think of a much easier way...
+{
 
     // Create blocks. Check right is if left is false, and we need to check the right one too. Continue block happens if true.
     auto* funcVal = (llvm::Function*)func.GetVariableValue(func.name);
@@ -33,6 +31,7 @@ llvm::Value* ASTExpressionOr::Compile(llvm::IRBuilder<>& builder, ASTFunction& f
     builder.SetInsertPoint(checkRight);
     llvm::Value* rightVal = a2->CompileRValue(builder, func);
     llvm::BasicBlock* lastBlockRight = builder.GetInsertBlock(); // In case the block has changed, fix it.
+    builder.CreateBr(cont);
 
     // Tell LLVM that it should either select the left value or the right one depending on where we came from.
     builder.SetInsertPoint(cont);
@@ -41,12 +40,4 @@ llvm::Value* ASTExpressionOr::Compile(llvm::IRBuilder<>& builder, ASTFunction& f
     res->addIncoming(rightVal, lastBlockRight);
     return res;
 
-}
-
-std::string ASTExpressionOr::ToString(const std::string& prefix)
-{
-    std::string ret = "(||)\n";
-    ret += prefix + "├──" + a1->ToString(prefix + "│  ");
-    ret += prefix + "└──" + a2->ToString(prefix + "   ");
-    return ret;
 }
\ No newline at end of file
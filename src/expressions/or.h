@@ -1,20 +1,20 @@
 #pragma once
 
-#include "../expression.h"
+#include "binary.h"
 
 // An expression that ors too boolean expressions together.
-class ASTExpressionOr : public ASTExpression
+class ASTExpressionOr : public ASTExpressionBinary
 {
 
 public:
-    // Operands to work with.
-    std::unique_ptr<ASTExpression> a1;
-    std::unique_ptr<ASTExpression> a2;
-    
+
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Or;
+
     // Create a new or expression.
     // a1: Left side expression of the or statement.
     // a2: Right side expression of the or statement.
-    ASTExpressionOr(std::unique_ptr<ASTExpression> a1, std::unique_ptr<ASTExpression> a2) : a1(std::move(a1)), a2(std::move(a2)) {}
+    ASTExpressionOr(std::unique_ptr<ASTExpression> a1, std::unique_ptr<ASTExpression> a2) : ASTExpressionBinary(KIND, std::move(a1), std::move(a2)) {}
 
     // Create a new or expression.
     // a1: Left side expression of the or statement.
@@ -25,9 +25,8 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> ReturnType(ASTFunction& func) override;
-    bool IsLValue(ASTFunction& func) override;
-    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    const char* Symbol() const override { return "||"; }
+    const VarType* ComputeReturnType(ASTFunction& func) override;
+    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const override;
 
 };
\ No newline at end of file
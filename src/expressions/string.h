@@ -9,12 +9,16 @@ class ASTExpressionString : public ASTExpression
 {
 
 public:
+
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::String;
+
     // Constant string value.
     std::string value;
     
     // Create a new constant string expression.
     // str: Constant string value to create.
-    explicit ASTExpressionString(std::string  str) : value(std::move(str)) {}
+    explicit ASTExpressionString(std::string  str) : ASTExpression(KIND), value(std::move(str)) {}
 
     // Create a new constant string expression.
     // str: Constant string value to create.
@@ -24,8 +28,9 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> ReturnType(ASTFunction& func) override;
-    bool IsLValue(ASTFunction& func) override;
-    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    const VarType* ComputeReturnType(ASTFunction& func) override;
+    bool IsLValue(ASTFunction& func) const override;
+    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 };
\ No newline at end of file
@@ -2,25 +2,19 @@
 
 #include "../function.h"
 
-std::unique_ptr<VarType> ASTExpressionVariable::ReturnType(ASTFunction& func)
+const VarType* ASTExpressionVariable::ComputeReturnType(ASTFunction& func)
 {
-    return func.GetVariableType(var)->Copy(); // We just need to resolve the variable and copy its type.
+    return func.GetVariableType(var); // We just need to resolve the variable. Its type lives in the scope table.
 }
 
-bool ASTExpressionVariable::IsLValue(ASTFunction& func)
+bool ASTExpressionVariable::IsLValue(ASTFunction& func) const
 {
-    auto retType = ReturnType(func);
-    return !dynamic_cast<VarTypeFunction*>(retType.get());
+    return !dynamic_cast<const VarTypeFunction*>(ReturnType());
     // If the variable is a function type, then we shouldn't load from it, it's just a raw function address.
     // Otherwise, we know that the variable is really just a pointer to some memory allocated somewhere and is thus an L-Value.
 }
 
-llvm::Value* ASTExpressionVariable::Compile(llvm::IRBuilder<>& builder, ASTFunction& func)
+llvm::Value* ASTExpressionVariable::Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const
 {
     return func.GetVariableValue(var); // Simply just return the value from the scope table.
-}
-
-std::string ASTExpressionVariable::ToString(const std::string& prefix)
-{
-    return var + "\n";
 }
\ No newline at end of file
@@ -1,31 +1,35 @@
 #pragma once
 
-#include <utility>
-
 #include "../expression.h"
+#include "../symbol.h"
 
 // An expression that resolves a variable.
 class ASTExpressionVariable : public ASTExpression
 {
 
 public:
+
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Variable;
+
     // Referenced variable.
-    std::string var;
+    Symbol var;
     
     // Resolve a variable. Functions are variables too!
     // var: Name of the variable to reference.
-    explicit ASTExpressionVariable(std::string var) : var(std::move(var)) {}
+    explicit ASTExpressionVariable(Symbol var) : ASTExpression(KIND), var(var) {}
 
     // Resolve a variable. Functions are variables too!
     // var: Name of the variable to reference.
-    static auto Create(const std::string& var)
+    static auto Create(Symbol var)
     {
         return std::make_unique<ASTExpressionVariable>(var);
     }
 
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> ReturnType(ASTFunction& func) override;
-    bool IsLValue(ASTFunction& func) override;
-    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    const VarType* ComputeReturnType(ASTFunction& func) override;
+    bool IsLValue(ASTFunction& func) const override;
+    llvm::Value* Compile(llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 };
\ No newline at end of file
@@ -0,0 +1,373 @@
+#include "flatAst.h"
+
+#include "statements/block.h"
+#include "statements/for.h"
+#include "statements/if.h"
+#include "statements/return.h"
+#include "statements/while.h"
+#include "expressions/and.h"
+#include "expressions/arithmetic.h"
+#include "expressions/assignment.h"
+#include "expressions/bool2Int.h"
+#include "expressions/bool.h"
+#include "expressions/call.h"
+#include "expressions/comparison.h"
+#include "expressions/float.h"
+#include "expressions/float2Int.h"
+#include "expressions/int.h"
+#include "expressions/int2Bool.h"
+#include "expressions/int2Float.h"
+#include "expressions/negative.h"
+#include "expressions/or.h"
+#include "expressions/string.h"
+#include "expressions/variable.h"
+#include <stdexcept>
+
+// Adds the nodes of a tree to a flat AST, children before their parent.
+class ASTFlattener : public ASTVisitor
+{
+
+    // Flat AST to add to.
+    FlatAST& flat;
+
+    // Handles of the children added so far for every node being added. Each node pops its own off the top when it is done.
+    std::vector<FlatHandle> pending;
+
+    // Handle of the last node added.
+    FlatHandle added = FLAT_NULL;
+
+    // Add a child of the node being added.
+    // node: Child to add. May be null.
+    void AddChild(const ASTStatement* node)
+    {
+        pending.push_back(Add(node));
+    }
+
+    // Add the node being visited after its children.
+    // node: Node to add.
+    // start: Size of the pending stack before its children were added.
+    // value: Value of the node, see FlatAST::values.
+    void Finish(const ASTStatement& node, size_t start, uint32_t value = 0)
+    {
+        added = (FlatHandle)flat.kinds.size();
+        flat.kinds.push_back(node.kind);
+        flat.firstChild.push_back((uint32_t)flat.children.size());
+        flat.childCount.push_back((uint32_t)(pending.size() - start));
+        flat.values.push_back(value);
+        flat.types.push_back(node.IsExpression() ? static_cast<const ASTExpression&>(node).ReturnType() : node.StatementReturnType());
+        flat.children.insert(flat.children.end(), pending.begin() + start, pending.end());
+        pending.resize(start);
+    }
+
+    // Add a node with two operands.
+    // node: Node to add.
+    // a1: Left operand.
+    // a2: Right operand.
+    void FinishBinary(const ASTStatement& node, const ASTStatement* a1, const ASTStatement* a2)
+    {
+        size_t start = pending.size();
+        AddChild(a1);
+        AddChild(a2);
+        Finish(node, start);
+    }
+
+    // Add a node with a single operand.
+    // node: Node to add.
+    // operand: Operand of the node.
+    void FinishUnary(const ASTStatement& node, const ASTStatement* operand)
+    {
+        size_t start = pending.size();
+        AddChild(operand);
+        Finish(node, start);
+    }
+
+public:
+
+    // Create a new flattener.
+    // flat: Flat AST to add to.
+    explicit ASTFlattener(FlatAST& flat) : flat(flat) {}
+
+    // Add a node and everything below it.
+    // node: Node to add. May be null.
+    // Returns: Handle of the node, or FLAT_NULL for a null node.
+    FlatHandle Add(const ASTStatement* node)
+    {
+        if (!node) return FLAT_NULL;
+        node->Accept(*this);
+        return added;
+    }
+
+    void Visit(const ASTStatementBlock& node) override
+    {
+        size_t start = pending.size();
+        for (auto& statement : node.statements) AddChild(statement.get());
+        Finish(node, start);
+    }
+
+    void Visit(const ASTStatementIf& node) override
+    {
+        size_t start = pending.size();
+        AddChild(node.condition.get());
+        AddChild(node.thenStatement.get());
+        AddChild(node.elseStatement.get());
+        Finish(node, start);
+    }
+
+    void Visit(const ASTStatementWhile& node) override
+    {
+        FinishBinary(node, node.condition.get(), node.thenStatement.get());
+    }
+
+    void Visit(const ASTStatementFor& node) override
+    {
+        size_t start = pending.size();
+        AddChild(node.init.get());
+        AddChild(node.condition.get());
+        AddChild(node.increment.get());
+        AddChild(node.body.get());
+        Finish(node, start);
+    }
+
+    void Visit(const ASTStatementReturn& node) override
+    {
+        FinishUnary(node, node.returnExpression.get());
+    }
+
+    void Visit(const ASTExpressionInt& node) override
+    {
+        Finish(node, pending.size(), (uint32_t)flat.ints.size());
+        flat.ints.push_back(node.value);
+    }
+
+    void Visit(const ASTExpressionFloat& node) override
+    {
+        Finish(node, pending.size(), (uint32_t)flat.floats.size());
+        flat.floats.push_back(node.value);
+    }
+
+    void Visit(const ASTExpressionBool& node) override
+    {
+        Finish(node, pending.size(), node.value ? 1 : 0);
+    }
+
+    void Visit(const ASTExpressionString& node) override
+    {
+        Finish(node, pending.size(), (uint32_t)flat.strings.size());
+        flat.strings.push_back(node.value);
+    }
+
+    void Visit(const ASTExpressionVariable& node) override
+    {
+        Finish(node, pending.size(), (uint32_t)flat.symbols.size());
+        flat.symbols.push_back(node.var);
+    }
+
+    void Visit(const ASTExpressionCall& node) override
+    {
+        size_t start = pending.size();
+        AddChild(node.callee.get());
+        for (auto& argument : node.arguments) AddChild(argument.get());
+        Finish(node, start);
+    }
+
+    void Visit(const ASTExpressionAssignment& node) override { FinishBinary(node, node.left.get(), node.right.get()); }
+    void Visit(const ASTExpressionNegation& node) override { FinishUnary(node, node.operand.get()); }
+    void Visit(const ASTExpressionInt2Float& node) override { FinishUnary(node, node.operand.get()); }
+    void Visit(const ASTExpressionFloat2Int& node) override { FinishUnary(node, node.operand.get()); }
+    void Visit(const ASTExpressionInt2Bool& node) override { FinishUnary(node, node.operand.get()); }
+    void Visit(const ASTExpressionBool2Int& node) override { FinishUnary(node, node.operand.get()); }
+
+    void Visit(const ASTExpressionBinary& node) override
+    {
+        size_t start = pending.size();
+        AddChild(node.a1.get());
+        AddChild(node.a2.get());
+        auto comparison = node.kind == ASTNodeKind::Comparison ? static_cast<const ASTExpressionComparison*>(&node) : nullptr;
+        Finish(node, start, comparison ? (uint32_t)comparison->type : 0); // Comparisons keep their type as the value.
+    }
+
+};
+
+FlatHandle FlatAST::Flatten(const ASTStatement* node)
+{
+    return ASTFlattener(*this).Add(node);
+}
+
+std::unique_ptr<ASTStatement> FlatAST::Unflatten(FlatHandle node) const
+{
+    if (node == FLAT_NULL) return nullptr;
+
+    // Children are built first, expressions need to be cast back to what the node classes take.
+    auto statement = [&](uint32_t index) { return Unflatten(Child(node, index)); };
+    auto expression = [&](uint32_t index) { return std::unique_ptr<ASTExpression>(static_cast<ASTExpression*>(Unflatten(Child(node, index)).release())); };
+    std::unique_ptr<ASTStatement> ret;
+    switch (kinds[node])
+    {
+        case ASTNodeKind::Block:
+        {
+            auto block = std::make_unique<ASTStatementBlock>();
+            for (uint32_t i = 0; i < childCount[node]; i++) block->statements.push_back(statement(i));
+            ret = std::move(block);
+            break;
+        }
+        case ASTNodeKind::If: ret = ASTStatementIf::Create(expression(0), statement(1), statement(2)); break;
+        case ASTNodeKind::While: ret = ASTStatementWhile::Create(expression(0), statement(1)); break;
+        case ASTNodeKind::For: ret = ASTStatementFor::Create(statement(3), statement(0), expression(1), statement(2)); break;
+        case ASTNodeKind::Return:
+        {
+            auto returnStatement = std::make_unique<ASTStatementReturn>();
+            returnStatement->returnExpression = expression(0);
+            ret = std::move(returnStatement);
+            break;
+        }
+        case ASTNodeKind::Int: ret = ASTExpressionInt::Create(ints[values[node]]); break;
+        case ASTNodeKind::Float: ret = ASTExpressionFloat::Create(floats[values[node]]); break;
+        case ASTNodeKind::Bool: ret = ASTExpressionBool::Create(values[node] != 0); break;
+        case ASTNodeKind::String: ret = ASTExpressionString::Create(strings[values[node]]); break;
+        case ASTNodeKind::Variable: ret = ASTExpressionVariable::Create(symbols[values[node]]); break;
+        case ASTNodeKind::Call:
+        {
+            std::vector<std::unique_ptr<ASTExpression>> arguments;
+            for (uint32_t i = 1; i < childCount[node]; i++) arguments.push_back(expression(i));
+            ret = ASTExpressionCall::Create(expression(0), std::move(arguments));
+            break;
+        }
+        case ASTNodeKind::Assignment: ret = ASTExpressionAssignment::Create(expression(0), expression(1)); break;
+        case ASTNodeKind::Addition: ret = ASTExpressionAddition::Create(expression(0), expression(1)); break;
+        case ASTNodeKind::Subtraction: ret = ASTExpressionSubtraction::Create(expression(0), expression(1)); break;
+        case ASTNodeKind::Multiplication: ret = ASTExpressionMultiplication::Create(expression(0), expression(1)); break;
+        case ASTNodeKind::Division: ret = ASTExpressionDivision::Create(expression(0), expression(1)); break;
+        case ASTNodeKind::Comparison: ret = ASTExpressionComparison::Create((ASTExpressionComparisonType)values[node], expression(0), expression(1)); break;
+        case ASTNodeKind::And: ret = ASTExpressionAnd::Create(expression(0), expression(1)); break;
+        case ASTNodeKind::Or: ret = ASTExpressionOr::Create(expression(0), expression(1)); break;
+        case ASTNodeKind::Negation: ret = ASTExpressionNegation::Create(expression(0)); break;
+        case ASTNodeKind::Int2Float: ret = ASTExpressionInt2Float::Create(expression(0)); break;
+        case ASTNodeKind::Float2Int: ret = ASTExpressionFloat2Int::Create(expression(0)); break;
+        case ASTNodeKind::Int2Bool: ret = ASTExpressionInt2Bool::Create(expression(0)); break;
+        case ASTNodeKind::Bool2Int: ret = ASTExpressionBool2Int::Create(expression(0)); break;
+        default: throw std::runtime_error("ERROR: Unknown node kind in flat AST!");
+    }
+
+    // Put back what type checking found.
+    if (ret->IsExpression()) static_cast<ASTExpression*>(ret.get())->type = types[node];
+    else ret->definiteReturnType = types[node];
+    return ret;
+
+}
+
+void FlatAST::Validate(const std::vector<FlatHandle>& roots) const
+{
+
+    // Every node needs an entry in each array.
+    size_t size = Size();
+    if (firstChild.size() != size || childCount.size() != size || values.size() != size || types.size() != size)
+        throw std::runtime_error("ERROR: Flat AST node arrays have different sizes!");
+
+    // Each node may be referenced once. A node referenced twice would be built once for every path to it, which is exponential in a chain of them.
+    std::vector<bool> referenced(size, false);
+    auto reference = [&](FlatHandle node)
+    {
+        if (referenced[node]) throw std::runtime_error("ERROR: Flat AST node has more than one parent!");
+        referenced[node] = true;
+    };
+    for (FlatHandle root : roots)
+    {
+        if (root == FLAT_NULL) continue;
+        if (root >= size) throw std::runtime_error("ERROR: Flat AST root out of range!");
+        reference(root);
+    }
+
+    for (FlatHandle node = 0; node < size; node++)
+    {
+
+        // Children must be in range and come before their parent.
+        uint32_t count = childCount[node];
+        if ((size_t)firstChild[node] + count > children.size()) throw std::runtime_error("ERROR: Flat AST node has children out of range!");
+        for (uint32_t i = 0; i < count; i++)
+        {
+            FlatHandle child = Child(node, i);
+            if (child == FLAT_NULL) continue;
+            if (child >= node) throw std::runtime_error("ERROR: Flat AST node has a child that does not come before it!");
+            reference(child);
+        }
+
+        // Check the children and value each kind of node expects.
+        auto expectChildren = [&](uint32_t expected)
+        {
+            if (count != expected) throw std::runtime_error("ERROR: Flat AST node has the wrong number of children!");
+        };
+        auto expectExpression = [&](uint32_t index, bool nullable)
+        {
+            FlatHandle child = Child(node, index);
+            if (child == FLAT_NULL ? !nullable : kinds[child] < ASTNodeKind::Int) throw std::runtime_error("ERROR: Flat AST node has a statement where an expression is expected!");
+        };
+        auto expectValue = [&](size_t end)
+        {
+            if (values[node] >= end) throw std::runtime_error("ERROR: Flat AST node has a value out of range!");
+        };
+        switch (kinds[node])
+        {
+            case ASTNodeKind::Block:
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    if (Child(node, i) == FLAT_NULL) throw std::runtime_error("ERROR: Flat AST block has a missing statement!");
+                }
+                break;
+            case ASTNodeKind::If:
+                expectChildren(3);
+                expectExpression(0, false);
+                break;
+            case ASTNodeKind::While:
+                expectChildren(2);
+                expectExpression(0, false);
+                break;
+            case ASTNodeKind::For:
+                expectChildren(4);
+                expectExpression(1, true);
+                break;
+            case ASTNodeKind::Return:
+                expectChildren(1);
+                expectExpression(0, true);
+                break;
+            case ASTNodeKind::Int: expectChildren(0); expectValue(ints.size()); break;
+            case ASTNodeKind::Float: expectChildren(0); expectValue(floats.size()); break;
+            case ASTNodeKind::Bool: expectChildren(0); expectValue(2); break;
+            case ASTNodeKind::String: expectChildren(0); expectValue(strings.size()); break;
+            case ASTNodeKind::Variable: expectChildren(0); expectValue(symbols.size()); break;
+            case ASTNodeKind::Call:
+                if (count == 0) throw std::runtime_error("ERROR: Flat AST call has no callee!");
+                for (uint32_t i = 0; i < count; i++) expectExpression(i, false);
+                break;
+            case ASTNodeKind::Assignment:
+                expectChildren(2);
+                expectExpression(1, false);
+                if (Child(node, 0) == FLAT_NULL || kinds[Child(node, 0)] != ASTNodeKind::Variable) throw std::runtime_error("ERROR: Flat AST assignment is not to a variable!");
+                break;
+            case ASTNodeKind::Comparison:
+                expectValue(GreaterThanOrEqual + 1);
+                [[fallthrough]];
+            case ASTNodeKind::Addition:
+            case ASTNodeKind::Subtraction:
+            case ASTNodeKind::Multiplication:
+            case ASTNodeKind::Division:
+            case ASTNodeKind::And:
+            case ASTNodeKind::Or:
+                expectChildren(2);
+                expectExpression(0, false);
+                expectExpression(1, false);
+                break;
+            case ASTNodeKind::Negation:
+            case ASTNodeKind::Int2Float:
+            case ASTNodeKind::Float2Int:
+            case ASTNodeKind::Int2Bool:
+            case ASTNodeKind::Bool2Int:
+                expectChildren(1);
+                expectExpression(0, false);
+                break;
+            default:
+                throw std::runtime_error("ERROR: Unknown node kind in flat AST!");
+        }
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "statement.h"
+#include "symbol.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Handle of a node in a flat AST, which is its index in the node arrays.
+typedef uint32_t FlatHandle;
+
+// Handle of a missing node, like the else branch of an if without one.
+constexpr FlatHandle FLAT_NULL = UINT32_MAX;
+
+// Nodes stored in contiguous arrays instead of a pointer-linked tree. Every node field has its own array indexed by handle, and the children of a node are a range of the shared children array.
+// Nodes are added children first, so a child always has a smaller handle than its parent. Walking the handles in order visits the tree from the bottom up without chasing pointers, and walking them backwards visits it from the top down.
+// Children are kept in the order of the node class's fields:
+//   Block: statements. If: condition, then, else. While: condition, then. For: init, condition, increment, body. Return: expression.
+//   Call: callee, arguments. Assignment: left, right. Binary operators: a1, a2. Negation and casts: operand.
+class FlatAST
+{
+public:
+
+    // Kind of each node.
+    std::vector<ASTNodeKind> kinds;
+
+    // Start of the children of each node in the children array.
+    std::vector<uint32_t> firstChild;
+
+    // Number of children of each node.
+    std::vector<uint32_t> childCount;
+
+    // Value of each node. For constants and variables this is an index into the matching value array, for bools it is the value, and for comparisons it is the comparison type.
+    std::vector<uint32_t> values;
+
+    // Type of each node. This is the type of an expression or the definite return type of a statement, and is null before type checking.
+    std::vector<const VarType*> types;
+
+    // Children of every node, as ranges given by firstChild and childCount. Missing children are FLAT_NULL.
+    std::vector<FlatHandle> children;
+
+    // Values of constants and variables, pointed to by values.
+    std::vector<int> ints;
+    std::vector<double> floats;
+    std::vector<std::string> strings;
+    std::vector<Symbol> symbols;
+
+    // Add a tree and everything below it.
+    // node: Root of the tree to add. May be null.
+    // Returns: Handle of the root, or FLAT_NULL for a null tree.
+    FlatHandle Flatten(const ASTStatement* node);
+
+    // Build a tree back from the nodes. Types are kept, so a tree that was type checked before flattening does not need to be checked again.
+    // node: Handle of the root of the tree to build. May be FLAT_NULL.
+    // Returns: The root of the new tree, or null for FLAT_NULL.
+    std::unique_ptr<ASTStatement> Unflatten(FlatHandle node) const;
+
+    // Get the number of nodes.
+    size_t Size() const { return kinds.size(); }
+
+    // Get a child of a node.
+    // node: Node to get the child of.
+    // index: Position of the child, see the class for the order of children.
+    // Returns: Handle of the child, which may be FLAT_NULL.
+    FlatHandle Child(FlatHandle node, uint32_t index) const { return children[firstChild[node] + index]; }
+
+    // Make sure the arrays form trees the node classes can be built from, like after reading them from a file.
+    // Every child has to come before its parent, which rules out cycles, and every node can be referenced only once, by a parent or as a root, which rules out shared subtrees that would be built over and over. Throws an exception if anything is wrong.
+    // roots: Handles of the roots of the trees that will be built. FLAT_NULL roots are skipped.
+    void Validate(const std::vector<FlatHandle>& roots) const;
+
+};
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+    Fast paths for the lexer to skip over long runs of characters that flex would otherwise step through one byte at a time.
+    Each scan looks at a whole block of 32 (AVX2) or 16 (SSE2) bytes per step, and falls back to a byte at a time without either.
+    Scans only stop at a character that ends the run, so the text must contain one. The null bytes at the end of every lexer buffer take care of that.
+    A block is never loaded across a page boundary, since the next page may lie past the end of the buffer. Near the end of a page, scans go a byte at a time instead.
+*/
+
+// If a character is whitespace the lexer skips.
+inline bool IsLexerWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// If a character ends the body of a string literal: a quote, an escape, a newline, or the end of the buffer.
+inline bool IsStringBodyEnd(char c)
+{
+    return c == '"' || c == '\\' || c == '\n' || c == 0;
+}
+
+// Skip whitespace one byte at a time.
+// text: Where to start skipping.
+// Returns: The first character that is not whitespace.
+inline const char* SkipWhitespaceScalar(const char* text)
+{
+    while (IsLexerWhitespace(*text)) text++;
+    return text;
+}
+
+// Skip the body of a string literal one byte at a time.
+// text: Where to start skipping.
+// Returns: The first character that ends the body.
+inline const char* SkipStringBodyScalar(const char* text)
+{
+    while (!IsStringBodyEnd(*text)) text++;
+    return text;
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+#if defined(__AVX2__)
+typedef __m256i CharBlock;
+typedef uint32_t CharBlockMask;
+static const size_t CHAR_BLOCK_SIZE = 32;
+inline CharBlock LoadCharBlock(const char* text) { return _mm256_loadu_si256((const __m256i*)text); }
+inline CharBlock MatchChar(CharBlock block, char c) { return _mm256_cmpeq_epi8(block, _mm256_set1_epi8(c)); }
+inline CharBlock MatchEither(CharBlock a, CharBlock b) { return _mm256_or_si256(a, b); }
+inline CharBlockMask MatchMask(CharBlock matches) { return (CharBlockMask)_mm256_movemask_epi8(matches); }
+#else
+typedef __m128i CharBlock;
+typedef uint32_t CharBlockMask;
+static const size_t CHAR_BLOCK_SIZE = 16;
+inline CharBlock LoadCharBlock(const char* text) { return _mm_loadu_si128((const __m128i*)text); }
+inline CharBlock MatchChar(CharBlock block, char c) { return _mm_cmpeq_epi8(block, _mm_set1_epi8(c)); }
+inline CharBlock MatchEither(CharBlock a, CharBlock b) { return _mm_or_si128(a, b); }
+inline CharBlockMask MatchMask(CharBlock matches) { return (CharBlockMask)_mm_movemask_epi8(matches); }
+#endif
+
+// Smallest page size, blocks are never loaded across a multiple of this.
+static const size_t CHAR_SCAN_PAGE_SIZE = 4096;
+
+// Mask with a bit set for every byte of a block.
+static const CharBlockMask CHAR_BLOCK_FULL = (CharBlockMask)((1ull << CHAR_BLOCK_SIZE) - 1);
+
+// Find the first character that ends a run.
+// text: Where to start.
+// isEnd: If a single character ends the run. Used where a block would cross a page.
+// blockEnds: Mask of the characters in a block that end the run.
+// Returns: The first character that ends the run.
+template <typename IsEnd, typename BlockEnds>
+inline const char* ScanRun(const char* text, IsEnd isEnd, BlockEnds blockEnds)
+{
+    while (true)
+    {
+        if ((uintptr_t)text % CHAR_SCAN_PAGE_SIZE > CHAR_SCAN_PAGE_SIZE - CHAR_BLOCK_SIZE)
+        {
+            if (isEnd(*text)) return text;
+            text++;
+            continue;
+        }
+        CharBlockMask ends = blockEnds(LoadCharBlock(text));
+        if (ends) return text + __builtin_ctz(ends);
+        text += CHAR_BLOCK_SIZE;
+    }
+}
+
+// Skip whitespace a block at a time.
+// text: Where to start skipping.
+// Returns: The first character that is not whitespace.
+inline const char* SkipWhitespace(const char* text)
+{
+    return ScanRun(text, [](char c) { return !IsLexerWhitespace(c); }, [](CharBlock block)
+    {
+        CharBlock spaces = MatchEither(MatchEither(MatchChar(block, ' '), MatchChar(block, '\t')), MatchEither(MatchChar(block, '\r'), MatchChar(block, '\n')));
+        return ~MatchMask(spaces) & CHAR_BLOCK_FULL;
+    });
+}
+
+// Skip the body of a string literal a block at a time.
+// text: Where to start skipping.
+// Returns: The first character that ends the body.
+inline const char* SkipStringBody(const char* text)
+{
+    return ScanRun(text, IsStringBodyEnd, [](CharBlock block)
+    {
+        CharBlock ends = MatchEither(MatchEither(MatchChar(block, '"'), MatchChar(block, '\\')), MatchEither(MatchChar(block, '\n'), MatchChar(block, 0)));
+        return MatchMask(ends);
+    });
+}
+
+#else
+
+// No vector instructions, so skip a byte at a time.
+inline const char* SkipWhitespace(const char* text) { return SkipWhitespaceScalar(text); }
+inline const char* SkipStringBody(const char* text) { return SkipStringBodyScalar(text); }
+
+#endif
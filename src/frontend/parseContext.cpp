@@ -0,0 +1,91 @@
+#include "parseContext.h"
+
+#include "../parallel.h"
+
+// Scanner state handle, same as the one flex defines.
+typedef void* yyscan_t;
+
+// These are defined in the generated lexer and parser.
+yyscan_t LexerBegin(ParseChunk& chunk);
+void LexerEnd(yyscan_t scanner);
+int yyparse(yyscan_t scanner, ParseChunk& chunk);
+
+std::vector<size_t> ParseContext::FindChunkBoundaries(size_t pieces)
+{
+    std::vector<size_t> boundaries = { 0 };
+    const char* text = source.Data();
+    size_t size = source.Size();
+    size_t target = size / pieces; // Pieces are balanced by size, which is close enough to the work it takes to parse them.
+    int depth = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        bool declEnd = false;
+        switch (text[i])
+        {
+            case '"': // Skip string literals, they may contain braces. This has to match how the lexer reads them.
+                for (i++; i < size && text[i] != '"'; i++)
+                {
+                    if (text[i] == '\\') i++;
+                }
+                break;
+            case '{':
+                depth++;
+                break;
+            case '}':
+                declEnd = --depth == 0; // A function body closed.
+                break;
+            case ';':
+                declEnd = depth == 0; // A function declaration ended.
+                break;
+        }
+        if (depth < 0) return { 0 }; // Unbalanced braces, let the parser report it on the whole input.
+        if (declEnd && i + 1 - boundaries.back() >= target && i + 1 < size) boundaries.push_back(i + 1);
+    }
+    return boundaries;
+}
+
+bool ParseContext::Parse(unsigned threads)
+{
+
+    // A lone chunk is scanned in place and allocates from the AST directly. Otherwise, every chunk is copied out to get the null bytes the lexer needs and allocates from its own arena.
+    std::vector<size_t> boundaries = threads > 1 ? FindChunkBoundaries(threads * 4) : std::vector<size_t> { 0 };
+    std::vector<ParseChunk> chunks;
+    chunks.reserve(boundaries.size());
+    if (boundaries.size() == 1) chunks.emplace_back(source, source.Data(), source.Size(), ast.GetArena());
+    else for (size_t i = 0; i < boundaries.size(); i++)
+    {
+        size_t end = i + 1 < boundaries.size() ? boundaries[i + 1] : source.Size();
+        size_t size = end - boundaries[i];
+        chunks.emplace_back(source, source.StoreForLexer(source.Data() + boundaries[i], size), size, ast.GetArena().AddChild());
+    }
+
+    // Parse every chunk.
+    std::vector<int> results(chunks.size());
+    RunParallel(chunks.size(), threads, [&](size_t i)
+    {
+        ArenaScope scope(chunks[i].arena); // Everything the parser creates goes into the chunk's arena.
+        yyscan_t scanner = LexerBegin(chunks[i]);
+        results[i] = yyparse(scanner, chunks[i]);
+        LexerEnd(scanner);
+    });
+    for (auto& chunk : chunks) ast.diagnostics += chunk.diagnostics;
+    for (int result : results)
+    {
+        if (result != 0) return false;
+    }
+
+    // Add the functions to the AST in input order.
+    auto scope = ast.UseArena();
+    for (auto& chunk : chunks)
+    {
+        for (auto& parsed : chunk.functions)
+        {
+            auto f = ast.AddFunction(parsed.name, parsed.returnType, std::move(parsed.parameters), parsed.variadic);
+            if (!parsed.definition) continue; // Only a declaration.
+            for (auto& var : parsed.stackVariables) f->AddStackVar(var);
+            f->Define(std::move(parsed.definition));
+        }
+    }
+    return true;
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "../ast.h"
+#include "sourceBuffer.h"
+#include <string>
+#include <vector>
+
+// A function as it comes out of the parser, before it is added to the AST.
+struct ParsedFunction
+{
+
+    // Name of the function.
+    Symbol name;
+
+    // Return type of the function.
+    const VarType* returnType;
+
+    // Parameters of the function.
+    ASTFunctionParameters parameters;
+
+    // If the function takes variadic arguments.
+    bool variadic = false;
+
+    // Local variables declared at the top of the body.
+    ASTFunctionParameters stackVariables;
+
+    // Body of the function. Null if this is only a declaration.
+    std::unique_ptr<ASTStatement> definition;
+
+};
+
+// A piece of the input that holds whole function declarations and definitions, parsed on its own.
+// The parser collects functions here instead of adding them to the AST directly, so chunks can be parsed on different threads and merged in input order afterwards.
+struct ParseChunk
+{
+
+    // Buffer the chunk belongs to.
+    SourceBuffer& source;
+
+    // Builds string literals for the chunk's scanner.
+    LiteralBuilder literal;
+
+    // Start of the text to scan. Must be followed by two null bytes.
+    char* text;
+
+    // Size of the text not counting the null bytes.
+    size_t size;
+
+    // Arena the chunk's nodes are allocated from.
+    Arena& arena;
+
+    // Functions parsed from the chunk, in input order.
+    std::vector<ParsedFunction> functions;
+
+    // Errors and warnings from scanning and parsing the chunk.
+    std::string diagnostics;
+
+    // Skip whitespace and string bodies a byte at a time instead of with the vector scans of charScan.h. Only the lexer benchmark sets this, to compare the two.
+    bool scalarScans = false;
+
+    // Create a new chunk.
+    // source: Buffer the chunk belongs to.
+    // text: Start of the text to scan. Must be followed by two null bytes.
+    // size: Size of the text not counting the null bytes.
+    // arena: Arena to allocate the chunk's nodes from.
+    ParseChunk(SourceBuffer& source, char* text, size_t size, Arena& arena) : source(source), literal(source), text(text), size(size), arena(arena) {}
+
+};
+
+// State of a single front end run: the input being parsed and the AST being built from it.
+// Nothing here is global, so separate contexts can parse at the same time on different threads.
+class ParseContext
+{
+
+    // Split the input into pieces that each hold one or more whole top level declarations, so they can be parsed independently.
+    // Braces are matched to find where each function ends, skipping over string literals.
+    // pieces: Roughly how many pieces to make. Declarations are never split, so there may be fewer.
+    // Returns: Offsets into the input where each piece starts. The first piece always starts at 0.
+    std::vector<size_t> FindChunkBoundaries(size_t pieces);
+
+public:
+
+    // Input to parse. Fill this in before parsing.
+    SourceBuffer source;
+
+    // AST built by the parser.
+    AST ast;
+
+    // Create a new parse context.
+    // modName: Name of the module the AST creates.
+    ParseContext(const std::string& modName) : ast(modName) {}
+
+    // Contexts are referenced by their scanner and parser while running, so they can't be copied or moved.
+    ParseContext(const ParseContext&) = delete;
+    ParseContext& operator=(const ParseContext&) = delete;
+
+    // Parse the source into the AST.
+    // threads: Number of threads to parse with. With more than one, the input is split at function boundaries and the pieces are parsed in parallel.
+    // Returns: If parsing succeeded.
+    bool Parse(unsigned threads = 1);
+
+};
@@ -1,3 +1,6 @@
+%skeleton "lalr1.cc"
+%require "3.2"
+
 %code requires {
   #include <stdio.h>
 #include <stdlib.h>
@@ -14,10 +17,7 @@
 #include "../src/expressions/bool.h"
 #include "../src/expressions/string.h"
 #include "../src/expressions/variable.h"
-#include "../src/expressions/addition.h"
-#include "../src/expressions/subtraction.h"
-#include "../src/expressions/multiplication.h"
-#include "../src/expressions/division.h"
+#include "../src/expressions/arithmetic.h"
 #include "../src/expressions/assignment.h"
 #include "../src/expressions/comparison.h"
 #include "../src/expressions/and.h"
@@ -28,56 +28,52 @@
 #include "../src/statements/if.h"
 #include "../src/statements/return.h"
 #include "../src/types/simple.h"
-extern FILE *yyin;
+#include "../src/frontend/parseContext.h"
+
+  //the scanner is reentrant, so its state is passed around as a handle instead of living in globals
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+  //parameters of a function declaration, and if the list ends in "..."
+  struct ParsedParameters {
+    ASTFunctionParameters parameters;
+    bool variadic = false;
+  };
  }
 
-%{
-#include "parser.tab.hh"
-
-  extern int yylex(void);
-  void yyerror(const char *s);
-  void save_to_dot(FILE *);
-  int trav_and_write(FILE *, node *);
-
-  AST ast("TestMod");
-%}
+%code provides {
+  int yylex(yy::parser::value_type *yylval_param, yyscan_t yyscanner);
+}
 
 %start program
 
 %define parse.error verbose
 
- /* You'll notice that the union has many more types than previously. Read over it to make sure you know what everything does.
-  * In particular, node that we do not store objects (or structs) in the union. Instead, it is better practice to store pointers. */
-%union {
-  bool boolval;
-  int intval;
-  double fltval;
-  char *strval;
-  struct node *nodeval;
-  ASTFunctionParameter *var;
-  std::vector<ASTFunctionParameter *> *vars;
-  ASTStatement *stmt;
-  std::vector<ASTStatement *> *stmtVec;
-  ASTExpression *exp;
-  std::vector<ASTExpression *> *exprVec;
-  VarType *type;
-  ASTExpressionComparisonType rel;
-}
+ /* All parser state lives in the chunk being parsed. Functions are collected there and added to the AST once every chunk is done, so chunks of the same input can be parsed at the same time. */
+%lex-param {yyscan_t scanner}
+%parse-param {yyscan_t scanner} {ParseChunk& chunk}
+
+ /* Semantic values are C++ variants, so they can hold smart pointers and vectors by value.
+  * Values are moved out of the $n's and into the AST, so nothing the parser creates is ever copied or leaked. */
+%define api.value.type variant
 
 %token ID BOOL_TYPE INT_TYPE FLOAT_TYPE STRING_TYPE VOID_TYPE SEMICOLON LPAREN RPAREN COMMA LBRACE RBRACE IF ELSE WHILE FOR BREAK RETURN EQUALS_SIGN LOGICAL_OR LOGICAL_AND LOGICAL_NOT RELOP_GT RELOP_LT RELOP_GE RELOP_LE RELOP_EQ RELOP_NE ARITH_PLUS ARITH_MINUS ARITH_MULT ARITH_DIV ARITH_MOD VARIADIC BOOL_LITERAL INT_LITERAL FLOAT_LITERAL STRING_LITERAL EOL
 
-%type <boolval> BOOL_LITERAL
-%type <strval> ID STRING_LITERAL
-%type <intval> int_lit INT_LITERAL
-%type <fltval> flt_lit FLOAT_LITERAL
-%type <var> varDec
-%type <vars> params paramList varDecs
-%type <stmt> stmt exprStmt selStmt iterStmt jumpStmt
-%type <stmtVec> stmts
-%type <exp> expr orExpr andExpr unaryRelExpr relExpr term factor primary call constant
-%type <exprVec> args
-%type <type> type
-%type <rel> relop
+%type <bool> BOOL_LITERAL
+%type <SourceText> ID STRING_LITERAL
+%type <int> int_lit INT_LITERAL
+%type <double> flt_lit FLOAT_LITERAL
+%type <ASTFunctionParameter> varDec
+%type <ASTFunctionParameters> varDecs
+%type <ParsedParameters> params paramList
+%type <std::unique_ptr<ASTStatement>> stmt exprStmt selStmt iterStmt jumpStmt
+%type <std::vector<std::unique_ptr<ASTStatement>>> stmts
+%type <std::unique_ptr<ASTExpression>> expr orExpr andExpr unaryRelExpr relExpr term factor primary call constant
+%type <std::vector<std::unique_ptr<ASTExpression>>> args
+%type <const VarType*> type
+%type <ASTExpressionComparisonType> relop
 
 %expect 1 // Shift/reduce conflict when resolving the if/else production; okay
 
@@ -88,133 +84,106 @@ decList: decList dec | dec ;
 dec: funDef | funDec ;
 
 type: BOOL_TYPE {
-  $$ = new VarTypeSimple(VarTypeSimple::BoolType);
+  $$ = &VarTypeSimple::BoolType;
  }| INT_TYPE {
-  $$ = new VarTypeSimple(VarTypeSimple::IntType);
+  $$ = &VarTypeSimple::IntType;
  }| FLOAT_TYPE {
-  $$ = new VarTypeSimple(VarTypeSimple::FloatType);
+  $$ = &VarTypeSimple::FloatType;
  }| STRING_TYPE {
-  $$ = new VarTypeSimple(VarTypeSimple::StringType);
+  $$ = &VarTypeSimple::StringType;
  } | VOID_TYPE {
-  $$ = new VarTypeSimple(VarTypeSimple::VoidType);
+  $$ = &VarTypeSimple::VoidType;
  };
 varDec: type ID {
-  //ASTFunctionParameter is just a tuple of a unique pointer to a type and a string (see definition in function.h)
-  $$ = new ASTFunctionParameter(std::unique_ptr<VarType>($1), $2);
+  //ASTFunctionParameter is just a tuple of a pointer to a type and a symbol (see definition in function.h)
+  $$ = ASTFunctionParameter($1, Symbol($2));
  };
 varDecs: varDecs varDec SEMICOLON {
-  $$ = $1; //We know that varDecs is always a pointer to vector of variables, so we can just copy it and push the next variable
-  $$->push_back($2);
+  $$ = std::move($1); //We know that varDecs is always a vector of variables, so we can just take it over and push the next variable
+  $$.push_back(std::move($2));
  } | {
-  $$ = new std::vector<ASTFunctionParameter *>();
+  $$ = ASTFunctionParameters();
  };
 
 funDec: type ID LPAREN params RPAREN SEMICOLON {
-  //create the parameters
-  auto parameters = ASTFunctionParameters();
-  bool variadic = false;
-  for(auto p : *$4) {
-    /* The AST uses unique pointers for memory purposes, but bison doesn't work well with those, so the parser uses plain C-style pointers.
-     * To account for this, make sure to dereference the pointers before using. */
-    if (p) parameters.push_back(std::move(*p));
-    else variadic = true;
-  }
-  //then make the function
-  auto f = ast.AddFunction($2, std::unique_ptr<VarType>($1), std::move(parameters), variadic);
+  //the parameters are already in the form the AST wants, so they can be moved right in
+  chunk.functions.push_back(ParsedFunction{Symbol($2), $1, std::move($4.parameters), $4.variadic});
 };
 
 funDef: type ID LPAREN params RPAREN LBRACE varDecs stmts RBRACE {
-   auto statements = new ASTStatementBlock();
-   for(auto s : *$8) {
-     statements->statements.push_back(std::unique_ptr<ASTStatement>(s));
-   }
-   auto parameters = ASTFunctionParameters();
-   bool variadic = false;
-   for(auto p : *$4) {
-     /* The AST uses unique pointers for memory purposes, but bison doesn't work well with those, so the parser uses plain C-style pointers.
-      * To account for this, make sure to dereference the pointers before using. */
-     if (p) parameters.push_back(std::move(*p));
-     else variadic = true;
-   }
-   //then make the function
-   auto f = ast.AddFunction($2, std::unique_ptr<VarType>($1), std::move(parameters), variadic);
-   for(auto s : *$7) {
-     f->AddStackVar(std::move(*s));
-   }
-   f->Define(std::unique_ptr<ASTStatementBlock>(statements));
+   auto statements = std::make_unique<ASTStatementBlock>();
+   statements->statements = std::move($8);
+   //then make the function, it gets added to the AST along with the rest of the chunk
+   chunk.functions.push_back(ParsedFunction{Symbol($2), $1, std::move($4.parameters), $4.variadic, std::move($7), std::move(statements)});
  };
-params: paramList | {$$ = new std::vector<ASTFunctionParameter *>();};
+params: paramList {$$ = std::move($1);} | {$$ = ParsedParameters();};
 paramList: paramList COMMA type ID { // This works similarly to varDecs
-  $$ = $1;
-  $$->push_back(new ASTFunctionParameter(std::unique_ptr<VarType>($3), $4));
+  $$ = std::move($1);
+  $$.parameters.push_back(ASTFunctionParameter($3, Symbol($4)));
  } | type ID {
-   $$ = new std::vector<ASTFunctionParameter *>();
-   $$->push_back(new ASTFunctionParameter(std::unique_ptr<VarType>($1), $2));
+   $$ = ParsedParameters();
+   $$.parameters.push_back(ASTFunctionParameter($1, Symbol($2)));
  } | paramList COMMA VARIADIC {
-  $$ = new std::vector<ASTFunctionParameter *>();
-  $$->push_back(nullptr); // Using a null pointer to indicate a variadic function (see funDec)
+  $$ = std::move($1);
+  $$.variadic = true;
  };
 
-stmt: exprStmt {$$ = $1;} | LBRACE stmts RBRACE {
-  //"stmts" is a vector of plain pointers to statements. We convert it to a statement block as follows:
-  auto statements = new ASTStatementBlock();
-  for(auto s : *$2) {
-    statements->statements.push_back(std::unique_ptr<ASTStatement>(s));
-  }
-  $$ = statements;
- }| selStmt {$$ = $1;} | iterStmt {$$ = $1;} | jumpStmt {$$ = $1;} ; // Strictly speaking, these {$$ = $1}s are unnecessary (bison does it for you).
+stmt: exprStmt {$$ = std::move($1);} | LBRACE stmts RBRACE {
+  //"stmts" is a vector of statements. We convert it to a statement block as follows:
+  auto statements = std::make_unique<ASTStatementBlock>();
+  statements->statements = std::move($2);
+  $$ = std::move(statements);
+ }| selStmt {$$ = std::move($1);} | iterStmt {$$ = std::move($1);} | jumpStmt {$$ = std::move($1);} ; // Values can't be copied, so unlike with plain pointers these moves are necessary.
 exprStmt: expr SEMICOLON {
-  $$ = $1; //implicit cast expr -> stmt
+  $$ = std::move($1); //implicit cast expr -> stmt
  } | SEMICOLON {
-  $$ = new ASTStatementBlock(); //empty statement = empty block
+  $$ = std::make_unique<ASTStatementBlock>(); //empty statement = empty block
  };
 stmts: stmts stmt {
   //Here, we just place the statements into a vector. They'll be added to the AST in a parent's code action.
-  $$ = $1;
-  $$->push_back($2);
+  $$ = std::move($1);
+  $$.push_back(std::move($2));
  }| {
-  $$ = new std::vector<ASTStatement *>();
+  $$ = std::vector<std::unique_ptr<ASTStatement>>();
  };
 selStmt: IF LPAREN expr RPAREN stmt {
-  $$ = new ASTStatementIf(std::unique_ptr<ASTExpression>($3), std::unique_ptr<ASTStatement>($5), std::unique_ptr<ASTStatement>(nullptr));
+  $$ = ASTStatementIf::Create(std::move($3), std::move($5), nullptr);
  } | IF LPAREN expr RPAREN stmt ELSE stmt {
-  $$ = new ASTStatementIf(std::unique_ptr<ASTExpression>($3), std::unique_ptr<ASTStatement>($5), std::unique_ptr<ASTStatement>($7));
+  $$ = ASTStatementIf::Create(std::move($3), std::move($5), std::move($7));
  };
 
 iterStmt: WHILE LPAREN expr RPAREN stmt {
-  $$ = new ASTStatementWhile(std::unique_ptr<ASTExpression>($3), std::unique_ptr<ASTStatement>($5));
+  $$ = ASTStatementWhile::Create(std::move($3), std::move($5));
  } | FOR LPAREN stmt expr SEMICOLON stmt RPAREN stmt {
-  $$ = new ASTStatementFor(std::unique_ptr<ASTStatement>($8), std::unique_ptr<ASTStatement>($3), std::unique_ptr<ASTExpression>($4), std::unique_ptr<ASTStatement>($6));
+  $$ = ASTStatementFor::Create(std::move($8), std::move($3), std::move($4), std::move($6));
  } | FOR LPAREN stmt SEMICOLON stmt RPAREN stmt {
-  $$ = new ASTStatementFor(std::unique_ptr<ASTStatement>($7), std::unique_ptr<ASTStatement>($3), std::unique_ptr<ASTExpression>(nullptr), std::unique_ptr<ASTStatement>($5));
+  $$ = ASTStatementFor::Create(std::move($7), std::move($3), nullptr, std::move($5));
  }; 
 
 jumpStmt: RETURN SEMICOLON {
-  auto retStmt = new ASTStatementReturn();
-  retStmt->returnExpression = std::unique_ptr<ASTExpression>(nullptr);
-  $$ = retStmt;
+  $$ = std::make_unique<ASTStatementReturn>();
  }| RETURN expr SEMICOLON {
-  auto retStmt = new ASTStatementReturn();
-  retStmt->returnExpression = std::unique_ptr<ASTExpression>($2);
-  $$ = retStmt;
+  auto retStmt = std::make_unique<ASTStatementReturn>();
+  retStmt->returnExpression = std::move($2);
+  $$ = std::move(retStmt);
  }; /* There should also be break statements here, but they are not implemented in the AST */
 
-expr: orExpr { $$ = $1;} | ID EQUALS_SIGN expr {
-  $$ = new ASTExpressionAssignment(ASTExpressionVariable::Create($1), std::unique_ptr<ASTExpression>($3));
+expr: orExpr { $$ = std::move($1);} | ID EQUALS_SIGN expr {
+  $$ = ASTExpressionAssignment::Create(ASTExpressionVariable::Create(Symbol($1)), std::move($3));
  };
-orExpr: andExpr {$$ = $1;} | orExpr LOGICAL_OR andExpr {
-  $$ = new ASTExpressionOr(std::unique_ptr<ASTExpression>($1), std::unique_ptr<ASTExpression>($3));
+orExpr: andExpr {$$ = std::move($1);} | orExpr LOGICAL_OR andExpr {
+  $$ = ASTExpressionOr::Create(std::move($1), std::move($3));
  };
-andExpr: unaryRelExpr {$$ = $1;} | andExpr LOGICAL_AND unaryRelExpr {
-  $$ = new ASTExpressionAnd(std::unique_ptr<ASTExpression>($1), std::unique_ptr<ASTExpression>($3));
+andExpr: unaryRelExpr {$$ = std::move($1);} | andExpr LOGICAL_AND unaryRelExpr {
+  $$ = ASTExpressionAnd::Create(std::move($1), std::move($3));
  };
 unaryRelExpr: LOGICAL_NOT unaryRelExpr {
   //logical not isn't implmented in ast, so we just don't do anything
-  $$ = $2;
- } | relExpr {$$ = $1;};
+  $$ = std::move($2);
+ } | relExpr {$$ = std::move($1);};
 relExpr: term relop term {
-  $$ = new ASTExpressionComparison($2, std::unique_ptr<ASTExpression>($1), std::unique_ptr<ASTExpression>($3));
- } | term {$$ = $1;};
+  $$ = ASTExpressionComparison::Create($2, std::move($1), std::move($3));
+ } | term {$$ = std::move($1);};
 relop: RELOP_GT {
   $$ = ASTExpressionComparisonType::GreaterThan;
  }| RELOP_LT {
@@ -228,165 +197,55 @@ relop: RELOP_GT {
  }| RELOP_NE {
   $$ = ASTExpressionComparisonType::NotEqual;
  };
-term: factor {$$ = $1;}| term ARITH_PLUS factor {
-  $$ = new ASTExpressionAddition(std::unique_ptr<ASTExpression>($1), std::unique_ptr<ASTExpression>($3));
+term: factor {$$ = std::move($1);}| term ARITH_PLUS factor {
+  $$ = ASTExpressionAddition::Create(std::move($1), std::move($3));
  }| term ARITH_MINUS factor {
-  $$ = new ASTExpressionSubtraction(std::unique_ptr<ASTExpression>($1), std::unique_ptr<ASTExpression>($3));
+  $$ = ASTExpressionSubtraction::Create(std::move($1), std::move($3));
  };
-factor: primary {$$ = $1;} | factor ARITH_MULT primary {
-  $$ = new ASTExpressionMultiplication(std::unique_ptr<ASTExpression>($1), std::unique_ptr<ASTExpression>($3));
+factor: primary {$$ = std::move($1);} | factor ARITH_MULT primary {
+  $$ = ASTExpressionMultiplication::Create(std::move($1), std::move($3));
  }| factor ARITH_DIV primary {
-  $$ = new ASTExpressionDivision(std::unique_ptr<ASTExpression>($1), std::unique_ptr<ASTExpression>($3));
+  $$ = ASTExpressionDivision::Create(std::move($1), std::move($3));
  }| factor ARITH_MOD primary {
   //not implemented in AST
-  $$ = $1;
+  $$ = std::move($1);
  };
 primary: ID {
-  $$ = new ASTExpressionVariable($1);
+  $$ = ASTExpressionVariable::Create(Symbol($1));
  }| LPAREN expr RPAREN {
-  $$ = $2;
+  $$ = std::move($2);
  } | call {
-  $$ = $1;
+  $$ = std::move($1);
  }| constant {
-  $$ = $1;
+  $$ = std::move($1);
  };
 call: ID LPAREN args RPAREN {
-  //convert args to a vector of unique ptrs:
-  auto argVec = std::vector<std::unique_ptr<ASTExpression>>();
-  for(auto a : *$3) {
-    argVec.push_back(std::unique_ptr<ASTExpression>(a));
-  }
-  $$ = new ASTExpressionCall(ASTExpressionVariable::Create($1), std::move(argVec));
+  //args is already a vector of unique ptrs, so it can be moved right into the call
+  $$ = ASTExpressionCall::Create(ASTExpressionVariable::Create(Symbol($1)), std::move($3));
  } | ID LPAREN RPAREN {
   //if there are no args, then just give it an empty vector
-  $$ = new ASTExpressionCall(ASTExpressionVariable::Create($1), std::vector<std::unique_ptr<ASTExpression>>());
+  $$ = ASTExpressionCall::Create(ASTExpressionVariable::Create(Symbol($1)), std::vector<std::unique_ptr<ASTExpression>>());
  };
  args: args COMMA expr {
-   $$ = $1;
-   $$->push_back($3);
+   $$ = std::move($1);
+   $$.push_back(std::move($3));
  } | expr {
-   $$ = new std::vector<ASTExpression *>();
-   $$->push_back($1);
+   $$ = std::vector<std::unique_ptr<ASTExpression>>();
+   $$.push_back(std::move($1));
  };
-constant: int_lit {$$ = new ASTExpressionInt($1);} | flt_lit {$$ = new ASTExpressionFloat($1);} | STRING_LITERAL {$$ = new ASTExpressionString(std::string($1));} | BOOL_LITERAL {$$ = new ASTExpressionBool($1);};
-int_lit: INT_LITERAL | ARITH_MINUS INT_LITERAL {$$ = -1 * $2;};
-flt_lit: FLOAT_LITERAL | ARITH_MINUS FLOAT_LITERAL {$$ = -1 * $2;};
+constant: int_lit {$$ = ASTExpressionInt::Create($1);} | flt_lit {$$ = ASTExpressionFloat::Create($1);} | STRING_LITERAL {$$ = ASTExpressionString::Create(std::string($1));} | BOOL_LITERAL {$$ = ASTExpressionBool::Create($1);};
+int_lit: INT_LITERAL {$$ = $1;} | ARITH_MINUS INT_LITERAL {$$ = -1 * $2;};
+flt_lit: FLOAT_LITERAL {$$ = $1;} | ARITH_MINUS FLOAT_LITERAL {$$ = -1 * $2;};
 
 %%
-int main(int argc, char **argv) {
-
-  // Arg flags:
-  bool showHelp = false; // Show the help and exit.
-  std::string openFile = ""; // File to open. Nothing for standard in.
-  std::string outFile = ""; // File to write to. Nothing for standard out.
-  int outputFormat = 3; // 0 - LLVM Assembly. 1 - LLVM Bitcode. 2 - Object (TODO). 3 - AST tree.
-  bool printAST = true; // If to print the AST to console.
-
-  // Read the arguments. Don't count the first which is the executable name.
-  for (int i = 1; i < argc; i++)
-  {
-    bool hasNextArg = i + 1 < argc;
-    std::string arg(argv[i]);
-    if (arg == "-i" && hasNextArg)
-    {
-      i++;
-      openFile = argv[i];
-    }
-    else if (arg == "-o" && hasNextArg)
-    {
-      i++;
-      outFile = argv[i];
-    }
-    else if (arg == "-nPrint")
-    {
-      printAST = false;
-    }
-    else if (arg == "-fAsm")
-    {
-      outputFormat = 0;
-    }
-    else if (arg == "-fBc")
-    {
-      outputFormat = 1;
-    }
-    else if (arg == "-fObj")
-    {
-      outputFormat = 2;
-    }
-    else if (arg == "-fAst")
-    {
-      outputFormat = 3;
-    }
-    else
-    {
-      showHelp = true;
-    }
-  }
-  printAST &= outputFormat != 3 && outFile != ""; // Always print AST by default in addition to whatever is being output.
-
-  // Show help if needed.
-  if (showHelp)
-  {
-    printf("Usage: LLVM-Lab [options]\n");
-    printf("\nOptions:\n\n");
-    printf("-h              Show this help screen.\n");
-    printf("-i [input]      Read from an input file (reads from console by default).\n");
-    printf("-o [output]     Write to an output file (writes to console by default).\n");
-    printf("-nPrint         If to not print the AST to the console.\n");
-    printf("-fAsm           Output format is in LLVM assembly.\n");
-    printf("-fAst           Output format is an abstract syntax tree.\n");
-    printf("-fBc            Output format is in LLVM bitcode.\n");
-    printf("-fObj           Output format is an object file.\n");
-    return 1;
-  }
-
-  // Fetch input.
-  if (openFile != "")
-  {
-    yyin = fopen(openFile.c_str(), "r");
-  }
-
-  if (yyparse() == 1)
-  {
-    printf("Irrecoverable error state, aborting\n");
-    return 1;
-  }
-
-  // Close input if needed.
-  if (openFile != "")
-  {
-    fclose(yyin);
-  }
-
-  ast.DeadCodeEliminationPass();
-
-  // Do the compilation.
-  ast.Compile();
-
-  // Print AST if needed.
-  if (printAST) std::cout << ast.ToString() << std::endl;
-
-  // Export data.
-  if (outputFormat == 0)
-  {
-    ast.WriteLLVMAssemblyToFile(outFile);
-  }
-  else if (outputFormat == 1)
-  {
-    ast.WriteLLVMBitcodeToFile(outFile);
-  }
-  else if (outputFormat == 2)
-  {
-    std::cout << "OBJ exporting not supported yet." << std::endl;
-  }
-  else
-  {
-    std::cout << ast.ToString() << std::endl;
-  }
-  return 0;
+void yy::parser::error(const std::string& s)
+{
+  chunk.diagnostics += "error: " + s + "\n";
 }
 
-void yyerror(const char *s)
+int yyparse(yyscan_t scanner, ParseChunk& chunk)
 {
-  fprintf(stderr, "error: %s\n", s);
+  // Run the generated parser. This is what ParseContext::Parse calls into for every chunk.
+  yy::parser parser(scanner, chunk);
+  return parser.parse();
 }
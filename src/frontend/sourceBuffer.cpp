@@ -0,0 +1,162 @@
+#include "sourceBuffer.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Size of each storage chunk. Bigger text gets a chunk of its own.
+static const size_t CHUNK_SIZE = 64 * 1024;
+
+SourceBuffer::~SourceBuffer()
+{
+    Release();
+}
+
+void SourceBuffer::Release()
+{
+    if (mappedSize) munmap(base, mappedSize);
+    owned.reset();
+    base = nullptr;
+    size = 0;
+    mappedSize = 0;
+}
+
+bool SourceBuffer::Map(const std::string& path)
+{
+    Release();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    /*
+        The lexer needs two null bytes after the input, but the file doesn't have them.
+        To get around this, we first reserve zeroed memory big enough for the file plus the null bytes, then map the file over the start of it.
+        Whatever is left past the end of the file is then guaranteed to be zero.
+        The mapping is private and writable since the lexer writes into the buffer, but those writes never make it back to the file.
+    */
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t fileSize = (size_t)info.st_size;
+    size_t reserveSize = (fileSize + 2 + pageSize - 1) / pageSize * pageSize;
+    void* reserved = mmap(nullptr, reserveSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED)
+    {
+        close(fd);
+        return false;
+    }
+    if (fileSize > 0 && mmap(reserved, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        munmap(reserved, reserveSize);
+        close(fd);
+        return false;
+    }
+    close(fd); // The mapping stays valid after the file is closed.
+    madvise(reserved, reserveSize, MADV_SEQUENTIAL); // The lexer reads straight through.
+
+    base = (char*)reserved;
+    size = fileSize;
+    mappedSize = reserveSize;
+    return true;
+}
+
+void SourceBuffer::Copy(std::string_view text)
+{
+    Release();
+
+    // Copy over and add the null bytes.
+    owned = std::make_unique<char[]>(text.size() + 2);
+    memcpy(owned.get(), text.data(), text.size());
+    owned[text.size()] = 0;
+    owned[text.size() + 1] = 0;
+    base = owned.get();
+    size = text.size();
+}
+
+void SourceBuffer::Read(FILE* file)
+{
+    std::string input;
+    char readBuf[CHUNK_SIZE];
+    size_t read;
+    while ((read = fread(readBuf, 1, sizeof(readBuf), file)) > 0) input.append(readBuf, read);
+    Copy(input);
+}
+
+char* SourceBuffer::Reserve(size_t length)
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+    if (length > chunkLeft)
+    {
+        size_t newSize = length > CHUNK_SIZE ? length : CHUNK_SIZE;
+        chunks.push_back(std::make_unique<char[]>(newSize));
+        chunkPos = chunks.back().get();
+        chunkLeft = newSize;
+    }
+    char* dest = chunkPos;
+    chunkPos += length;
+    chunkLeft -= length;
+    return dest;
+}
+
+SourceText SourceBuffer::Store(const char* text, size_t length)
+{
+    if (length == 0) return SourceText { "", 0 };
+    char* dest = Reserve(length);
+    memcpy(dest, text, length);
+    return SourceText { dest, length };
+}
+
+char* SourceBuffer::StoreForLexer(const char* text, size_t length)
+{
+    char* dest = Reserve(length + 2);
+    memcpy(dest, text, length);
+    dest[length] = 0;
+    dest[length + 1] = 0;
+    return dest;
+}
+
+void LiteralBuilder::Begin()
+{
+    literalView = nullptr;
+    literalViewSize = 0;
+    literal.clear();
+}
+
+void LiteralBuilder::Append(const char* text, size_t length)
+{
+    if (length == 0) return;
+    if (!literalView && literal.empty()) // First piece, just remember where it is.
+    {
+        literalView = text;
+        literalViewSize = length;
+        return;
+    }
+    FlattenLiteral();
+    literal.append(text, length);
+}
+
+void LiteralBuilder::Append(char c)
+{
+    FlattenLiteral();
+    literal.push_back(c);
+}
+
+void LiteralBuilder::FlattenLiteral()
+{
+    if (literalView) // The literal is no longer one piece, so it has to be copied.
+    {
+        literal.append(literalView, literalViewSize);
+        literalView = nullptr;
+    }
+}
+
+SourceText LiteralBuilder::End()
+{
+    if (literalView) return buffer.View(literalView, literalViewSize);
+    return buffer.Store(literal.data(), literal.size());
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A piece of text owned by a source buffer. This is kept trivial so it can be stored in the parser's value union.
+struct SourceText
+{
+
+    // Start of the text. Not null terminated!
+    const char* data;
+
+    // Length of the text in bytes.
+    size_t size;
+
+    // Convert to a view. Strings and symbols can be constructed from this.
+    operator std::string_view() const { return std::string_view(data, size); }
+
+};
+
+// Holds the entire input of a compilation in memory, either memory-mapped from a file, read in from a stream, or copied from memory.
+// The lexer scans the buffer in place, and the text of every token is handed out as a view into it.
+// Text that can't be viewed in place (string literals with escapes) goes to storage owned by this buffer, so everything lives exactly as long as the compilation.
+// Multiple scanners may work on different parts of the buffer at once, so storing text is thread safe.
+class SourceBuffer
+{
+
+    // Start of the input, which is followed by two null bytes for the lexer.
+    char* base = nullptr;
+
+    // Size of the input not counting the null bytes.
+    size_t size = 0;
+
+    // Size of the memory mapping, 0 if the input is not mapped.
+    size_t mappedSize = 0;
+
+    // Input that was read in instead of being mapped.
+    std::unique_ptr<char[]> owned;
+
+    // Storage for text that does not exist verbatim in the input. Chunks never move, so views into them stay valid.
+    std::vector<std::unique_ptr<char[]>> chunks;
+
+    // Free space at the end of the current chunk.
+    char* chunkPos = nullptr;
+    size_t chunkLeft = 0;
+
+    // Guards the storage chunks.
+    std::mutex storeMutex;
+
+    // Free the current input.
+    void Release();
+
+    // Reserve space in the storage chunks.
+    // length: Number of bytes to reserve.
+    // Returns: Start of the reserved space.
+    char* Reserve(size_t length);
+
+public:
+
+    // Create an empty buffer.
+    SourceBuffer() = default;
+
+    // The buffer may be referenced by views, so it can't be copied or moved.
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    // Unmap or free the input.
+    ~SourceBuffer();
+
+    // Memory-map a file as the input.
+    // path: Path of the file to map.
+    // Returns: If the file was mapped successfully.
+    bool Map(const std::string& path);
+
+    // Copy text in memory as the input.
+    // text: Text to copy.
+    void Copy(std::string_view text);
+
+    // Read an entire stream as the input.
+    // file: Stream to read until the end.
+    void Read(FILE* file);
+
+    // Start of the input. The buffer is writable, as the lexer temporarily null terminates tokens in place.
+    char* Data() { return base; }
+
+    // Size of the input not counting the null bytes.
+    size_t Size() const { return size; }
+
+    // Size of the input plus the two null bytes the lexer expects at the end.
+    size_t LexerSize() const { return size + 2; }
+
+    // Copy text into storage owned by this buffer.
+    // text: Text to store.
+    // length: Length of the text.
+    // Returns: A view of the stored text.
+    SourceText Store(const char* text, size_t length);
+
+    // Copy part of the input into storage owned by this buffer so it can be scanned on its own. Views into the copy stay valid like views into the input.
+    // text: Start of the text to copy.
+    // length: Length of the text.
+    // Returns: Start of the copy, which is followed by the two null bytes the lexer expects.
+    char* StoreForLexer(const char* text, size_t length);
+
+    // Get a view of text that lies inside the input. No copy is made.
+    // text: Start of the text, must point into the input.
+    // length: Length of the text.
+    // Returns: A view of the text.
+    SourceText View(const char* text, size_t length) const { return SourceText { text, length }; }
+
+};
+
+// Builds string literals for one scanner. Each scanner needs its own, as literals are built up over several tokens.
+class LiteralBuilder
+{
+
+    // Buffer to store literals in.
+    SourceBuffer& buffer;
+
+    // String literal being built. If it is a single piece of the input, it is kept as a view and not copied.
+    const char* literalView = nullptr;
+    size_t literalViewSize = 0;
+    std::string literal;
+
+    // Copy the current string literal out of the input so more can be added to it.
+    void FlattenLiteral();
+
+public:
+
+    // Create a new literal builder.
+    // buffer: Buffer that the scanned input belongs to. Literals that have to be copied are stored in it.
+    explicit LiteralBuilder(SourceBuffer& buffer) : buffer(buffer) {}
+
+    // Start building a new string literal.
+    void Begin();
+
+    // Add a piece of the input to the current string literal.
+    // text: Start of the piece. It must stay valid until the literal has been parsed.
+    // length: Length of the piece.
+    void Append(const char* text, size_t length);
+
+    // Add a single character to the current string literal.
+    // c: Character to add.
+    void Append(char c);
+
+    // Finish the current string literal.
+    // Returns: A view of the literal. It is only copied if it is not a single piece of the input.
+    SourceText End();
+
+};
\ No newline at end of file
@@ -1,83 +1,89 @@
 #include "function.h"
 
 #include "ast.h"
+#include "printer.h"
 #include "types/simple.h"
 #include <llvm/IR/Verifier.h>
 
-ASTFunction::ASTFunction(AST& ast, const std::string& name, std::unique_ptr<VarType> returnType, ASTFunctionParameters parameters, bool variadic) : ast(ast), name(name)
+ASTFunction::ASTFunction(AST& ast, Symbol name, const VarType* returnType, ASTFunctionParameters parameters, bool variadic) : ast(ast), name(name)
 {
 
     // Create the function type.
     auto params = std::move(parameters);
-    std::vector<std::unique_ptr<VarType>> paramTypes;
-    for (auto& param : params) // We must copy each type from the parameters.
+    std::vector<const VarType*> paramTypes;
+    for (auto& param : params) // Gather each type from the parameters.
     {
-        paramTypes.push_back(std::get<0>(param)->Copy()); // This copies the first item of the tuple, which is a var type pointer.
+        paramTypes.push_back(std::get<0>(param)); // This is the first item of the tuple, which is a var type pointer.
     }
-    funcType = std::make_unique<VarTypeFunction>(std::move(returnType), std::move(paramTypes), variadic);
+    funcType = ast.types.GetFunctionType(returnType, std::move(paramTypes), variadic);
 
     // Add to scope table, we need to error if it already exists.
-    if (!ast.scopeTable.AddVariable(name, funcType->Copy()))
+    if (!ast.scopeTable.AddVariable(name, funcType))
     {
-        throw std::runtime_error("ERROR: Function or global variable with name " + name + " already exists.");
+        throw std::runtime_error("ERROR: Function or global variable with name " + name.Name() + " already exists.");
     }
 
     // Add parameters as stack variables. It's ok for us to do it since we are the ones setting up the parameters for stack variables.
     for (auto& param : params)
     {
         this->parameters.push_back(std::get<1>(param));
-        AddStackVar(std::move(param));
+        AddStackVar(param);
     }
 
 }
 
+ASTFunction::~ASTFunction()
+{
+    ASTStatement::Destroy(std::move(definition));
+}
+
 void ASTFunction::AddStackVar(ASTFunctionParameter var)
 {
 
     // Add variable to the scope table and error if it already exists.
-    if (!scopeTable.AddVariable(std::get<1>(var), std::move(std::get<0>(var))))
+    if (!scopeTable.AddVariable(std::get<1>(var), std::get<0>(var)))
     {
-        throw std::runtime_error("ERROR: Variable " + std::get<1>(var) + " is already defined in function " + name + "!");
+        throw std::runtime_error("ERROR: Variable " + std::get<1>(var).Name() + " is already defined in function " + name.Name() + "!");
     }
     stackVariables.push_back(std::get<1>(var));
 
 }
 
-VarType* ASTFunction::GetVariableType(const std::string& name)
+const VarType* ASTFunction::GetVariableType(Symbol name)
 {
-    VarType* ret;
+    const VarType* ret;
     if (ret = scopeTable.GetVariableType(name), !ret) // Continue only if function scope table doesn't have value.
     {
         if (ret = ast.scopeTable.GetVariableType(name), !ret) // Continue only if AST scope table doesn't have value.
         {
-            throw std::runtime_error("ERROR: In function " + this->name + ", cannot resolve variable or function " + name + "!");
+            throw std::runtime_error("ERROR: In function " + this->name.Name() + ", cannot resolve variable or function " + name.Name() + "!");
         }
         else return ret;
     }
     else return ret;
 }
 
-llvm::Value* ASTFunction::GetVariableValue(const std::string& name)
+llvm::Value* ASTFunction::GetVariableValue(Symbol name)
 {
     llvm::Value* ret;
     if (ret = scopeTable.GetVariableValue(name), !ret) // Continue only if function scope table doesn't have value.
     {
         if (ret = ast.scopeTable.GetVariableValue(name), !ret) // Continue only if AST scope table doesn't have value.
         {
-            throw std::runtime_error("ERROR: In function " + this->name + ", cannot resolve variable or function " + name + "!");
+            throw std::runtime_error("ERROR: In function " + this->name.Name() + ", cannot resolve variable or function " + name.Name() + "!");
         }
         else return ret;
     }
     else return ret;
 }
 
-void ASTFunction::SetVariableValue(const std::string& name, llvm::Value* value)
+void ASTFunction::SetVariableValue(Symbol name, llvm::Value* value)
 {
     if (!scopeTable.SetVariableValue(name, value)) // Continue only if function scope table doesn't have value.
     {
         if (!ast.scopeTable.SetVariableValue(name, value)) // Continue only if AST scope table doesn't have value.
         {
-            throw std::runtime_error("ERROR: In function " + this->name + ", cannot resolve variable or function " + name + "!");
+            throw std::runtime_error("ERROR: In function " + this->name.Name() + ", cannot resolve variable or function " + name.Name() + "!");
         }
     }
 }
@@ -88,19 +94,39 @@ void ASTFunction::Define(std::unique_ptr<ASTStatement> definition)
     {
         this->definition = std::move(definition);
     }
-    else throw std::runtime_error("ERROR: Function " + name + " already has a definition!");
+    else throw std::runtime_error("ERROR: Function " + name.Name() + " already has a definition!");
+}
+
+void ASTFunction::TypeCheck()
+{
+
+    // Only continue if the function has a definition.
+    if (!definition) return;
+
+    // Type check the function body, which adds implicit casts and gives every expression its type.
+    definition->TypeCheck(*this);
+
+    // Check the function body to make sure it returns what we expect it to.
+    const VarType* retType = definition->StatementReturnType();
+    bool satisfiesType = !retType && funcType->returnType->Equals(&VarTypeSimple::VoidType); // If we return nothing and expect void, it works.
+    if (!satisfiesType && retType) satisfiesType = retType->Equals(funcType->returnType); // If we return something, make sure we return what is expected.
+    if (!satisfiesType)
+    {
+        throw std::runtime_error("ERROR: Function " + name.Name() + " does not return what it should!");
+    }
+
 }
 
 void ASTFunction::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder)
 {
 
     // First, add a new function declaration to our scope.
-    auto func = llvm::Function::Create((llvm::FunctionType*)funcType->GetLLVMType(builder.getContext()), llvm::GlobalValue::LinkageTypes::ExternalLinkage, name, mod);
+    auto func = llvm::Function::Create((llvm::FunctionType*)funcType->GetLLVMType(builder.getContext()), llvm::GlobalValue::LinkageTypes::ExternalLinkage, name.Name(), mod);
     ast.scopeTable.SetVariableValue(name, func);
 
     // Set parameter names.
     unsigned idx = 0;
-    for (auto& arg : func->args()) arg.setName(parameters[idx++]);
+    for (auto& arg : func->args()) arg.setName(parameters[idx++].Name());
 
     // Only continue if the function has a definition.
     if (!definition) return;
@@ -124,43 +150,36 @@ void ASTFunction::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder)
     {
         scopeTable.SetVariableValue(
             stackVar,
-            builder.CreateAlloca(scopeTable.GetVariableType(stackVar)->GetLLVMType(builder.getContext()), nullptr, stackVar)
+            builder.CreateAlloca(scopeTable.GetVariableType(stackVar)->GetLLVMType(builder.getContext()), nullptr, stackVar.Name())
         );
     }
 
     // Now we need to store the initial values of the function arguments into their stack equivalents.
+    idx = 0;
     for (auto& arg : func->args())
     {
-        builder.CreateStore(&arg, scopeTable.GetVariableValue(arg.getName().data())); // We are storing the argument into the pointer to the stack variable gotten by fetching it from the scope table.
-    }
-
-    // Check the function body to make sure it returns what we expect it to.
-    std::unique_ptr<VarType> retType = definition->StatementReturnType(*this);
-    bool satisfiesType = !retType && funcType->returnType->Equals(&VarTypeSimple::VoidType); // If we return nothing and expect void, it works.
-    if (!satisfiesType && retType) satisfiesType = retType->Equals(funcType->returnType.get()); // If we return something, make sure we return what is expected.
-    if (!satisfiesType)
-    {
-        throw std::runtime_error("ERROR: Function " + name + " does not return what it should!");
+        builder.CreateStore(&arg, scopeTable.GetVariableValue(parameters[idx++])); // We are storing the argument into the pointer to the stack variable gotten by fetching it from the scope table.
     }
 
     // Generate the function.
     definition->Compile(mod, builder, *this);
 
     // Add an implicit return void if necessary.
-    if (!retType)
+    if (!definition->StatementReturnType())
     {
         builder.CreateRetVoid();
     }
 
-    // Verify and optimize the function.
-    llvm::verifyFunction(*func, &llvm::errs());
+    // Verify and optimize the function. Problems go to the AST's diagnostics.
+    llvm::raw_string_ostream verifyOut(ast.diagnostics);
+    llvm::verifyFunction(*func, &verifyOut);
+    verifyOut.flush();
     ast.fpm.run(*func);
 
 }
 
-std::string ASTFunction::ToString(const std::string& prefix)
+void ASTFunction::Print(std::ostream& out, const std::string& prefix)
 {
-    std::string output = name + "\n";
-    output += prefix + "└──" + (definition == nullptr ? "nullptr\n" : definition->ToString(prefix + "   "));
-    return output;
+    out << name.Name() << "\n" << prefix << "└──";
+    ASTPrinter(out, prefix + "   ").Print(definition.get());
 }
\ No newline at end of file
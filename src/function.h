@@ -2,10 +2,12 @@
 
 #include "scopeTable.h"
 #include "statement.h"
+#include "symbol.h"
 #include "types/function.h"
 #include "varType.h"
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Function.h>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -13,7 +15,7 @@
 class AST;
 
 // Parameter typedef for simplicity.
-typedef std::tuple<std::unique_ptr<VarType>, std::string> ASTFunctionParameter;
+typedef std::tuple<const VarType*, Symbol> ASTFunctionParameter;
 
 // Function parameters typedef for simplicity.
 typedef std::vector<ASTFunctionParameter> ASTFunctionParameters;
@@ -25,10 +27,10 @@ class ASTFunction
 public:
 
     // List of all the parameters.
-    std::vector<std::string> parameters;
+    std::vector<Symbol> parameters;
 
     // List of all stack variables.
-    std::vector<std::string> stackVariables;
+    std::vector<Symbol> stackVariables;
 
     // Function scope table.
     ScopeTable scopeTable;
@@ -40,10 +42,10 @@ public:
     std::unique_ptr<ASTStatement> definition = nullptr;
 
     // Name of the function.
-    std::string name;
+    Symbol name;
 
     // Function type.
-    std::unique_ptr<VarTypeFunction> funcType;
+    const VarTypeFunction* funcType;
 
     // Create a new function. Will automatically be added to the AST's scope table.
     // ast: AST to link to. Will be added to its scope table.
@@ -51,36 +53,44 @@ public:
     // returnType: The type of variable the function will return.
     // parameters: Collection of variable types and names to pass to the function call.
     // variadic: If the function is a variadic function.
-    ASTFunction(AST& ast, const std::string& name, std::unique_ptr<VarType> returnType, ASTFunctionParameters parameters, bool variadic = false);
+    ASTFunction(AST& ast, Symbol name, const VarType* returnType, ASTFunctionParameters parameters, bool variadic = false);
+
+    // Free the definition, which may happen on any thread, so it is freed without recursing.
+    ~ASTFunction();
 
     // Add a new stack variable to the function's scope table. Don't add function parameters, those are already added.
     // var: Variable declaration to add to the stack.
     void AddStackVar(ASTFunctionParameter var);
 
-    // Get a variable's type. Note that you should not modify the pointer, or else bad things can happen.
+    // Get a variable's type.
     // name: Name of the variable to fetch.
     // Returns: Returns the type of the variable. If the variable does not exist, an exception is thrown.
-    VarType* GetVariableType(const std::string& name);
+    const VarType* GetVariableType(Symbol name);
 
     // Get a variable's value.
     // name: Name of the variable to fetch.
     // Returns: Returns the value of the variable. If the variable does not exist, an exception is thrown.
-    llvm::Value* GetVariableValue(const std::string& name);
+    llvm::Value* GetVariableValue(Symbol name);
 
     // Set a variable's value. Will cause an exception if the variable does not exist.
     // name: Name of the variable to set.
     // value: New value of the variable.
-    void SetVariableValue(const std::string& name, llvm::Value* value);
+    void SetVariableValue(Symbol name, llvm::Value* value);
 
     // Give the function a definition! This is necessary if the function is not linked to when compiling (as in its our own function creation).
     // definition: Function definition, which is just a statement.
     void Define(std::unique_ptr<ASTStatement> definition);
 
-    // Get a string representation of this function.
+    // Print this function as a tree.
+    // out: Stream to print to.
     // prefix: the prefix of this node's children. This string has length 3 * the depth of this node.
-    std::string ToString(const std::string& prefix);
+    void Print(std::ostream& out, const std::string& prefix);
+
+    // Type check the function body, which adds implicit casts and gives every node its types, and make sure it returns what it should.
+    // This is the only stage that changes the body after parsing and optimizing, compiling only reads it.
+    void TypeCheck();
 
-    // Compile the function, needed during codegen phase to show LLVM our function exists.
+    // Compile the function, needed during codegen phase to show LLVM our function exists. The body must be type checked first.
     // mod: Module to add the function to.
     // builder: IR builder used to build instructions.
     void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder);
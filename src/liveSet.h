@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A set of variables numbered densely from 0, stored as one bit per variable. Whole sets are combined a word of 64 variables at a time.
+class LiveSet
+{
+
+    // Bits of the set, with variable i at bit i % 64 of word i / 64.
+    std::vector<uint64_t> words;
+
+public:
+
+    // Create an empty set.
+    // size: Number of variables the set can hold.
+    explicit LiveSet(size_t size = 0) : words((size + 63) / 64) {}
+
+    // Check if a variable is in the set.
+    // var: Number of the variable.
+    bool Test(uint32_t var) const { return (words[var / 64] >> (var % 64)) & 1; }
+
+    // Add a variable to the set.
+    // var: Number of the variable.
+    void Set(uint32_t var) { words[var / 64] |= (uint64_t)1 << (var % 64); }
+
+    // Remove a variable from the set.
+    // var: Number of the variable.
+    void Reset(uint32_t var) { words[var / 64] &= ~((uint64_t)1 << (var % 64)); }
+
+    // Add every variable of another set that holds the same number of variables.
+    // other: Set to add.
+    // Returns: If any variable was not in the set before.
+    bool UnionWith(const LiveSet& other)
+    {
+        uint64_t added = 0;
+        for (size_t i = 0; i < words.size(); i++)
+        {
+            added |= other.words[i] & ~words[i];
+            words[i] |= other.words[i];
+        }
+        return added != 0;
+    }
+
+    // Check if two sets hold the same variables.
+    bool operator==(const LiveSet& other) const { return words == other.words; }
+    bool operator!=(const LiveSet& other) const { return words != other.words; }
+
+};
\ No newline at end of file
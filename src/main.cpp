@@ -0,0 +1,163 @@
+#include "compiler.h"
+#include "server.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+// Command line interface. All the work is done by the compiler library, see compiler.h.
+int main(int argc, char **argv)
+{
+
+    // Arg flags:
+    bool showHelp = false; // Show the help and exit.
+    std::vector<std::string> openFiles; // Files to open. None for standard in.
+    std::vector<std::string> openAstFiles; // Binary AST files to open instead of parsing.
+    std::string outFile = ""; // File to write to. Nothing for standard out.
+    int outputFormat = 3; // 0 - LLVM Assembly. 1 - LLVM Bitcode. 2 - Object (TODO). 3 - AST tree. 4 - Binary AST.
+    bool printAST = true; // If to print the AST to console.
+    bool serve = false; // Run as a compile server instead.
+    std::string serverSocket = ""; // Socket to serve on. Nothing for standard in and out.
+    CompileOptions options;
+    options.threads = 0; // One per hardware thread.
+
+    // Read the arguments. Don't count the first which is the executable name.
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasNextArg = i + 1 < argc;
+        std::string arg(argv[i]);
+        if (arg == "-i" && hasNextArg)
+        {
+            i++;
+            openFiles.push_back(argv[i]);
+        }
+        else if (arg == "-iAstBin" && hasNextArg)
+        {
+            i++;
+            openAstFiles.push_back(argv[i]);
+        }
+        else if (arg == "-j" && hasNextArg)
+        {
+            i++;
+            options.threads = (unsigned)atoi(argv[i]);
+        }
+        else if (arg == "-o" && hasNextArg)
+        {
+            i++;
+            outFile = argv[i];
+        }
+        else if (arg == "--server")
+        {
+            serve = true;
+        }
+        else if (arg == "--server-socket" && hasNextArg)
+        {
+            i++;
+            serve = true;
+            serverSocket = argv[i];
+        }
+        else if (arg == "-nPrint")
+        {
+            printAST = false;
+        }
+        else if (arg == "-fAsm")
+        {
+            outputFormat = 0;
+        }
+        else if (arg == "-fBc")
+        {
+            outputFormat = 1;
+        }
+        else if (arg == "-fObj")
+        {
+            outputFormat = 2;
+        }
+        else if (arg == "-fAst")
+        {
+            outputFormat = 3;
+        }
+        else if (arg == "-fAstBin")
+        {
+            outputFormat = 4;
+        }
+        else
+        {
+            showHelp = true;
+        }
+    }
+    printAST &= outputFormat != 3 && outFile != ""; // Always print AST by default in addition to whatever is being output.
+
+    // Show help if needed.
+    if (showHelp)
+    {
+        printf("Usage: LLVM-Lab [options]\n");
+        printf("\nOptions:\n\n");
+        printf("-h              Show this help screen.\n");
+        printf("-i [input]      Read from an input file (reads from console by default). Can be given multiple times to link many files together.\n");
+        printf("-iAstBin [input]  Read a binary AST file made with -fAstBin instead of parsing source. Can be given multiple times.\n");
+        printf("-j [threads]    Number of files to compile at once (one per hardware thread by default).\n");
+        printf("-o [output]     Write to an output file (writes to console by default).\n");
+        printf("-nPrint         If to not print the AST to the console.\n");
+        printf("--server        Serve compile requests from the console until it is closed, see server.h for the protocol.\n");
+        printf("--server-socket [path]  Serve compile requests from clients of a Unix domain socket.\n");
+        printf("-fAsm           Output format is in LLVM assembly.\n");
+        printf("-fAst           Output format is an abstract syntax tree.\n");
+        printf("-fAstBin        Output format is a binary abstract syntax tree, which can be compiled later without parsing.\n");
+        printf("-fBc            Output format is in LLVM bitcode.\n");
+        printf("-fObj           Output format is an object file.\n");
+        return 1;
+    }
+
+    // Serve requests if needed. The thread count is the number of requests compiled at once.
+    if (serve)
+    {
+        Server server(options.threads);
+        if (serverSocket == "")
+        {
+            server.ServeStdio();
+            return 0;
+        }
+        server.ServeSocket(serverSocket);
+        std::cerr << "ERROR: Could not serve on socket " << serverSocket << "!" << std::endl;
+        return 1;
+    }
+
+    if ((outputFormat == 0 || outputFormat == 1 || outputFormat == 4) && outFile == "")
+    {
+        const char* formatNames[] = { "assembly", "bitcode", "", "", "binary AST" };
+        std::cerr << "ERROR: Writing " << formatNames[outputFormat] << " to standard out is not supported!" << std::endl;
+        return 1;
+    }
+
+    // Parse, optimize, and compile every input, then link them together.
+    const CompileFormat formats[] = { CompileFormat::Assembly, CompileFormat::Bitcode, CompileFormat::None, CompileFormat::Ast, CompileFormat::AstBinary };
+    options.format = formats[outputFormat];
+    options.printAst = printAST;
+    CompileResult result = CompileFiles(openFiles, options, openAstFiles);
+    std::cerr << result.diagnostics;
+    if (!result.success)
+    {
+        return 1;
+    }
+
+    // Print AST if needed.
+    std::cout << result.ast;
+
+    // Export data.
+    if (outputFormat == 2)
+    {
+        std::cout << "OBJ exporting not supported yet." << std::endl;
+    }
+    else if (outputFormat == 3)
+    {
+        std::cout << result.output;
+    }
+    else
+    {
+        std::ofstream out(outFile, std::ios::binary);
+        out << result.output;
+    }
+    return 0;
+
+}
@@ -0,0 +1,92 @@
+#include "parallel.h"
+
+#include <stdexcept>
+
+// If the current thread is a thread of the pool.
+static thread_local bool onWorker = false;
+
+WorkerPool::WorkerPool() : maxThreads(std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+WorkerPool& WorkerPool::Get()
+{
+    static WorkerPool pool;
+    return pool;
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    tasksChanged.notify_all();
+    for (pthread_t thread : threads) pthread_join(thread, nullptr);
+}
+
+void WorkerPool::Submit(std::function<void()> task)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    tasks.push_back(std::move(task));
+
+    // Every thread is busy, so start a new one unless the pool is full. Then the task waits for a thread to finish, which always happens since no task waits on one that hasn't started.
+    if (idle < tasks.size() && threads.size() < maxThreads)
+    {
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setstacksize(&attr, WORKER_STACK_SIZE);
+        pthread_t thread;
+        int error = pthread_create(&thread, &attr, Start, this);
+        pthread_attr_destroy(&attr);
+        if (error)
+        {
+
+            // The task can still wait for one of the threads there are, but with none it would never run.
+            if (threads.empty())
+            {
+                tasks.pop_back();
+                throw std::runtime_error("ERROR: Could not start a worker thread!");
+            }
+            return;
+
+        }
+        threads.push_back(thread);
+        idle++; // Counted as idle until it takes its first task, so the next submission doesn't start another one for this task.
+    }
+    else tasksChanged.notify_one();
+}
+
+bool WorkerPool::OnWorker()
+{
+    return onWorker;
+}
+
+void* WorkerPool::Start(void* self)
+{
+    onWorker = true;
+    static_cast<WorkerPool*>(self)->WorkerLoop();
+    return nullptr;
+}
+
+void WorkerPool::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+
+        // Wait for a task.
+        tasksChanged.wait(lock, [&]() { return !tasks.empty() || stopping; });
+        if (tasks.empty()) return; // Stopping and nothing left to do.
+        std::function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        idle--;
+
+        // Run it without holding the lock, so others can be submitted and taken meanwhile.
+        lock.unlock();
+        task();
+        lock.lock();
+        idle++;
+
+    }
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <thread>
+#include <vector>
+
+// Stack size of worker threads. Passes over the AST recurse once for each level of nesting, so deeply nested input needs far more than the default.
+// Pages of a stack are only backed by memory once touched, so this costs nothing for shallow input.
+constexpr size_t WORKER_STACK_SIZE = (size_t)512 * 1024 * 1024;
+
+// Threads with stacks of WORKER_STACK_SIZE that run tasks as they are submitted. There is one pool for the whole process, so its threads are made once and reused by every parallel run instead of being started for each.
+// A thread is added whenever a task is submitted and every thread is busy, up to one per hardware thread. After that tasks wait for a free thread, which is safe since a task only ever waits on tasks that already run.
+class WorkerPool
+{
+
+    // Threads of the pool. They run until the pool is destroyed.
+    std::vector<pthread_t> threads;
+
+    // Most threads the pool starts.
+    const size_t maxThreads;
+
+    // Tasks waiting for a thread, in the order they were submitted.
+    std::deque<std::function<void()>> tasks;
+
+    // Number of threads waiting for a task.
+    size_t idle = 0;
+
+    // Guards everything above and the stopping flag.
+    std::mutex mutex;
+
+    // Signaled when a task is added or the pool stops.
+    std::condition_variable tasksChanged;
+
+    // Set once the pool is being destroyed. Threads finish the remaining tasks, then exit.
+    bool stopping = false;
+
+    // Take tasks and run them until the pool stops.
+    void WorkerLoop();
+
+    // Entry point of every thread.
+    // self: The pool the thread belongs to.
+    static void* Start(void* self);
+
+    WorkerPool();
+
+public:
+
+    // Get the pool of the process, creating it on first use.
+    static WorkerPool& Get();
+
+    // Finish the remaining tasks, then stop every thread.
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Run a task on a thread of the pool. Throws if the pool has no thread and can't start one.
+    // task: Task to run. It must not throw, RunParallel catches the exceptions of its jobs and passes them back to its caller.
+    void Submit(std::function<void()> task);
+
+    // If the calling thread is a thread of the pool, so it has a stack of WORKER_STACK_SIZE.
+    static bool OnWorker();
+
+};
+
+// Run a job for every index in [0, count) on threads of the worker pool, while the calling thread waits.
+// Jobs are handed out in order, one at a time, so uneven jobs still balance out.
+// Jobs run on stacks of WORKER_STACK_SIZE, so they may recurse as deep as the input is nested. A caller that already is a worker runs jobs itself as well, and runs them all inline if it is the only thread.
+// If a job throws, no more jobs are started and the first exception is thrown again once the running ones are done. The same goes for failing to hand jobs to the pool.
+// count: Number of jobs to run.
+// threads: Maximum number of threads to use. 0 uses one per hardware thread.
+// job: Function called with the index of each job. It must be safe to call from multiple threads at once.
+template <typename Job>
+void RunParallel(size_t count, unsigned threads, Job job)
+{
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads > count) threads = (unsigned)count;
+    if (threads == 0) return;
+
+    // Shared with the helpers, since a helper may only get a thread after the run is over. It then finds no jobs left and never touches the job.
+    struct RunState
+    {
+        std::atomic<size_t> next { 0 };
+        size_t count;
+        Job* job;
+        std::exception_ptr error;
+        std::atomic<bool> failed { false };
+        size_t running = 0;
+        size_t exited = 0;
+        std::mutex mutex;
+        std::condition_variable changed;
+    };
+    auto state = std::make_shared<RunState>();
+    state->count = count;
+    state->job = &job;
+
+    // Take the next job until there are none left or one has failed.
+    auto runJobs = [](RunState& state)
+    {
+        for (size_t i = state.next++; i < state.count && !state.failed; i = state.next++)
+        {
+            try
+            {
+                (*state.job)(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if (!state.error) state.error = std::current_exception();
+                state.failed = true;
+            }
+        }
+    };
+    auto helper = [state, runJobs]()
+    {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->running++;
+        }
+        runJobs(*state);
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->running--;
+            state->exited++;
+        }
+        state->changed.notify_all();
+    };
+
+    // A worker already has a big stack, so it takes part in the run. Any other thread has to leave every job to the pool and wait for all the helpers it submitted.
+    bool onWorker = WorkerPool::OnWorker();
+    unsigned helpers = 0;
+    try
+    {
+        for (unsigned wanted = onWorker ? threads - 1 : threads; helpers < wanted; helpers++) WorkerPool::Get().Submit(helper);
+    }
+    catch (...)
+    {
+
+        // Helpers that were submitted still use the job, so they must be done before it goes away.
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->error) state->error = std::current_exception();
+        state->failed = true;
+
+    }
+    if (onWorker) runJobs(*state);
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->changed.wait(lock, [&]() { return onWorker ? state->running == 0 : state->exited == helpers; }); // Once the caller ran out of jobs, helpers that start later can't claim any.
+    }
+    if (state->error) std::rethrow_exception(state->error);
+}
@@ -0,0 +1,186 @@
+#include "printer.h"
+
+#include "statements/block.h"
+#include "statements/for.h"
+#include "statements/if.h"
+#include "statements/return.h"
+#include "statements/while.h"
+#include "expressions/arithmetic.h"
+#include "expressions/assignment.h"
+#include "expressions/bool2Int.h"
+#include "expressions/bool.h"
+#include "expressions/call.h"
+#include "expressions/float.h"
+#include "expressions/float2Int.h"
+#include "expressions/int.h"
+#include "expressions/int2Bool.h"
+#include "expressions/int2Float.h"
+#include "expressions/negative.h"
+#include "expressions/string.h"
+#include "expressions/variable.h"
+
+void ASTPrinter::Print(const ASTStatement* node)
+{
+    size_t rootLength = prefix.size();
+    work.push_back({ node, rootLength, Branch::Inline });
+    while (!work.empty())
+    {
+        Item item = work.back();
+        work.pop_back();
+
+        // Draw the line to the parent and extend the prefix for the node's own children.
+        prefix.resize(item.prefixLength);
+        if (item.branch != Branch::Inline)
+        {
+            bool last = item.branch == Branch::Last;
+            out << prefix << (last ? "└──" : "├──");
+            prefix += last ? "   " : "│  ";
+        }
+
+        // The visit prints the node's line and queues its children, which go on the stack backwards so the first pops first.
+        if (item.node) item.node->Accept(*this);
+        else out << "nullptr\n";
+        work.insert(work.end(), children.rbegin(), children.rend());
+        children.clear();
+    }
+    prefix.resize(rootLength);
+}
+
+void ASTPrinter::PrintChild(const ASTStatement* node, bool last)
+{
+    children.push_back({ node, prefix.size(), last ? Branch::Last : Branch::Middle });
+}
+
+void ASTPrinter::PrintEscaped(const std::string& value)
+{
+    out << '"';
+    for (char c : value) // We want escaped strings to show up as non-escaped.
+    {
+        switch (c)
+        {
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default: out << c; break;
+        }
+    }
+    out << '"';
+}
+
+void ASTPrinter::PrintBinary(const char* op, const ASTStatement* a1, const ASTStatement* a2)
+{
+    out << "(" << op << ")\n";
+    PrintChild(a1, false);
+    PrintChild(a2, true);
+}
+
+void ASTPrinter::PrintUnary(const char* name, const ASTStatement* operand)
+{
+    out << name << "\n";
+    PrintChild(operand, true);
+}
+
+void ASTPrinter::Visit(const ASTStatementBlock& node)
+{
+    out << "block\n";
+    for (size_t i = 0; i < node.statements.size(); i++)
+        PrintChild(node.statements[i].get(), i == node.statements.size() - 1);
+}
+
+void ASTPrinter::Visit(const ASTStatementIf& node)
+{
+    out << "if\n";
+    PrintChild(node.condition.get(), false);
+    PrintChild(node.thenStatement.get(), !node.elseStatement); // The else branch is only shown if there is one.
+    if (node.elseStatement) PrintChild(node.elseStatement.get(), true);
+}
+
+void ASTPrinter::Visit(const ASTStatementWhile& node)
+{
+    out << "while\n";
+    PrintChild(node.condition.get(), false);
+    PrintChild(node.thenStatement.get(), true);
+}
+
+void ASTPrinter::Visit(const ASTStatementFor& node)
+{
+    out << "for\n";
+    PrintChild(node.body.get(), false);
+    PrintChild(node.init.get(), false);
+    PrintChild(node.condition.get(), false);
+    PrintChild(node.increment.get(), true);
+}
+
+void ASTPrinter::Visit(const ASTStatementReturn& node)
+{
+    out << "return\n";
+    if (node.returnExpression) PrintChild(node.returnExpression.get(), true);
+}
+
+void ASTPrinter::Visit(const ASTExpressionInt& node)
+{
+    out << std::to_string(node.value) << "\n";
+}
+
+void ASTPrinter::Visit(const ASTExpressionFloat& node)
+{
+    out << std::to_string(node.value) << "\n";
+}
+
+void ASTPrinter::Visit(const ASTExpressionBool& node)
+{
+    out << std::to_string(node.value) << "\n";
+}
+
+void ASTPrinter::Visit(const ASTExpressionString& node)
+{
+    PrintEscaped(node.value);
+    out << "\n";
+}
+
+void ASTPrinter::Visit(const ASTExpressionVariable& node)
+{
+    out << node.var.Name() << "\n";
+}
+
+void ASTPrinter::Visit(const ASTExpressionCall& node)
+{
+    children.push_back({ node.callee.get(), prefix.size(), Branch::Inline }); // The callee goes on the line of the call itself.
+    for (size_t i = 0; i < node.arguments.size(); i++)
+        PrintChild(node.arguments[i].get(), i == node.arguments.size() - 1);
+}
+
+void ASTPrinter::Visit(const ASTExpressionAssignment& node)
+{
+    PrintBinary("=", node.left.get(), node.right.get());
+}
+
+void ASTPrinter::Visit(const ASTExpressionBinary& node)
+{
+    PrintBinary(node.Symbol(), node.a1.get(), node.a2.get());
+}
+
+void ASTPrinter::Visit(const ASTExpressionNegation& node)
+{
+    PrintUnary("(-)", node.operand.get());
+}
+
+void ASTPrinter::Visit(const ASTExpressionInt2Float& node)
+{
+    PrintUnary("int2Float", node.operand.get());
+}
+
+void ASTPrinter::Visit(const ASTExpressionFloat2Int& node)
+{
+    PrintUnary("float2Int", node.operand.get());
+}
+
+void ASTPrinter::Visit(const ASTExpressionInt2Bool& node)
+{
+    PrintUnary("int2bool", node.operand.get());
+}
+
+void ASTPrinter::Visit(const ASTExpressionBool2Int& node)
+{
+    PrintUnary("bool2Int", node.operand.get());
+}
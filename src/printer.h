@@ -0,0 +1,100 @@
+#pragma once
+
+#include "statement.h"
+#include "visitor.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Prints nodes as a tree, one node per line, with lines drawn from every node to its children. Text goes straight to a stream.
+class ASTPrinter : public ASTVisitor
+{
+
+    // How a node to print hangs off its parent.
+    enum class Branch
+    {
+        Inline, // On the line of the parent, like the callee of a call.
+        Middle, // A child with more after it.
+        Last // The last child, which ends the line down to the children.
+    };
+
+    // A node waiting to be printed.
+    struct Item
+    {
+
+        // Node to print. May be null.
+        const ASTStatement* node;
+
+        // Length of the prefix the node goes under.
+        size_t prefixLength;
+
+        // How it hangs off its parent.
+        Branch branch;
+
+    };
+
+    // Stream to print to.
+    std::ostream& out;
+
+    // Put on the left of every line of the node being printed, except the first.
+    // This is a stack shared by every level of the tree, each child pushes its part on the end and it is cut back to the parent's length when a sibling is printed.
+    std::string prefix;
+
+    // Nodes left to print, with the next one at the back. Trees are walked with this instead of recursion, so nesting is only limited by memory.
+    std::vector<Item> work;
+
+    // Children queued by the node being visited, in the order they print.
+    std::vector<Item> children;
+
+    // Queue a child of the node being printed.
+    // node: Child to print. May be null.
+    // last: If this is the last child, which ends the line down to the children.
+    void PrintChild(const ASTStatement* node, bool last);
+
+    // Print an operator with two operands.
+    // op: Name of the operator.
+    // a1: Left operand.
+    // a2: Right operand.
+    void PrintBinary(const char* op, const ASTStatement* a1, const ASTStatement* a2);
+
+    // Print a conversion with a single operand.
+    // name: Name of the conversion.
+    // operand: Operand to convert.
+    void PrintUnary(const char* name, const ASTStatement* operand);
+
+    // Print an escaped string literal.
+    // value: String to print.
+    void PrintEscaped(const std::string& value);
+
+public:
+
+    // Create a new printer.
+    // out: Stream to print to.
+    // prefix: The string to be inserted on the left side of the tree.
+    ASTPrinter(std::ostream& out, std::string prefix = "") : out(out), prefix(std::move(prefix)) {}
+
+    // Print a node and everything below it, in the form of a tree data structure. Null nodes print as nullptr.
+    // node: Node to print.
+    void Print(const ASTStatement* node);
+
+    // Virtual functions. See base class for details.
+    void Visit(const ASTStatementBlock& node) override;
+    void Visit(const ASTStatementIf& node) override;
+    void Visit(const ASTStatementWhile& node) override;
+    void Visit(const ASTStatementFor& node) override;
+    void Visit(const ASTStatementReturn& node) override;
+    void Visit(const ASTExpressionInt& node) override;
+    void Visit(const ASTExpressionFloat& node) override;
+    void Visit(const ASTExpressionBool& node) override;
+    void Visit(const ASTExpressionString& node) override;
+    void Visit(const ASTExpressionVariable& node) override;
+    void Visit(const ASTExpressionCall& node) override;
+    void Visit(const ASTExpressionAssignment& node) override;
+    void Visit(const ASTExpressionBinary& node) override;
+    void Visit(const ASTExpressionNegation& node) override;
+    void Visit(const ASTExpressionInt2Float& node) override;
+    void Visit(const ASTExpressionFloat2Int& node) override;
+    void Visit(const ASTExpressionInt2Bool& node) override;
+    void Visit(const ASTExpressionBool2Int& node) override;
+
+};
@@ -0,0 +1,785 @@
+#include "rangeAnalysis.h"
+
+#include "function.h"
+#include "statements/block.h"
+#include "statements/for.h"
+#include "statements/if.h"
+#include "statements/return.h"
+#include "statements/while.h"
+#include "expressions/assignment.h"
+#include "expressions/bool.h"
+#include "expressions/bool2Int.h"
+#include "expressions/call.h"
+#include "expressions/float2Int.h"
+#include "expressions/int.h"
+#include "expressions/int2Bool.h"
+#include "expressions/int2Float.h"
+#include "expressions/negative.h"
+#include "expressions/variable.h"
+#include <algorithm>
+
+// Get the comparison that is true when another one is false.
+static ASTExpressionComparisonType Negate(ASTExpressionComparisonType type)
+{
+    switch (type)
+    {
+        case Equal: return NotEqual;
+        case NotEqual: return Equal;
+        case LessThan: return GreaterThanOrEqual;
+        case LessThanOrEqual: return GreaterThan;
+        case GreaterThan: return LessThanOrEqual;
+        case GreaterThanOrEqual: return LessThan;
+    }
+    return type;
+}
+
+// Get the comparison that is the same as another one with its operands swapped.
+static ASTExpressionComparisonType Swap(ASTExpressionComparisonType type)
+{
+    switch (type)
+    {
+        case LessThan: return GreaterThan;
+        case LessThanOrEqual: return GreaterThanOrEqual;
+        case GreaterThan: return LessThan;
+        case GreaterThanOrEqual: return LessThanOrEqual;
+        default: return type;
+    }
+}
+
+Interval Interval::Join(const Interval& other) const
+{
+    if (IsEmpty()) return other;
+    if (other.IsEmpty()) return *this;
+    return Of(std::min(low, other.low), std::max(high, other.high));
+}
+
+Interval Interval::Meet(const Interval& other) const
+{
+    return Of(std::max(low, other.low), std::min(high, other.high));
+}
+
+Interval Interval::Widen(const Interval& next) const
+{
+    if (IsEmpty()) return next;
+    if (next.IsEmpty()) return *this;
+    return Of(next.low < low ? INT_MIN : low, next.high > high ? INT_MAX : high);
+}
+
+Interval Interval::Narrow(const Interval& next) const
+{
+    if (next.IsEmpty()) return *this;
+    return Of(low == INT_MIN ? next.low : low, high == INT_MAX ? next.high : high);
+}
+
+void RangeAnalyzer::RangeState::Join(const RangeState& other)
+{
+    if (!other.reachable) return;
+    if (!reachable)
+    {
+        *this = other;
+        return;
+    }
+    for (size_t i = 0; i < ranges.size(); i++) ranges[i] = ranges[i].Join(other.ranges[i]);
+}
+
+void RangeAnalyzer::RangeState::Widen(const RangeState& next)
+{
+    if (!next.reachable) return;
+    if (!reachable)
+    {
+        *this = next;
+        return;
+    }
+    for (size_t i = 0; i < ranges.size(); i++) ranges[i] = ranges[i].Widen(next.ranges[i]);
+}
+
+bool RangeAnalyzer::RangeState::Narrow(const RangeState& next)
+{
+    if (!reachable || !next.reachable) return false;
+    bool changed = false;
+    for (size_t i = 0; i < ranges.size(); i++)
+    {
+        Interval narrowed = ranges[i].Narrow(next.ranges[i]);
+        changed |= narrowed != ranges[i];
+        ranges[i] = narrowed;
+    }
+    return changed;
+}
+
+bool RangeAnalyzer::RangeState::Includes(const RangeState& other) const
+{
+    if (!other.reachable) return true;
+    if (!reachable) return false;
+    for (size_t i = 0; i < ranges.size(); i++)
+    {
+        if (!ranges[i].Includes(other.ranges[i])) return false;
+    }
+    return true;
+}
+
+bool RangeAnalyzer::AnalyzeFunction(ASTFunction& function)
+{
+    if (!function.definition) return false;
+
+    // Parameters are among the stack variables, so this numbers every variable. Parameters and variables not assigned yet can be anything.
+    indices.clear();
+    kinds.clear();
+    loops.clear();
+    RangeState entry;
+    for (uint32_t i = 0; i < function.stackVariables.size(); i++)
+    {
+        indices.emplace(function.stackVariables[i], i);
+        const VarType* type = function.GetVariableType(function.stackVariables[i]);
+        if (type->Equals(&VarTypeSimple::IntType)) kinds.push_back(ValueKind::Int);
+        else if (type->Equals(&VarTypeSimple::BoolType)) kinds.push_back(ValueKind::Bool);
+        else kinds.push_back(ValueKind::Other);
+        entry.ranges.push_back(kinds.back() == ValueKind::Bool ? Interval::Bool() : Interval::Top());
+    }
+    recordedAssignments.assign(kinds.size(), 0);
+    recordedReturns = 0;
+    replaced = false;
+    record = true;
+    solvingDepth = 0;
+
+    state = &entry;
+    Walk(function.definition.get());
+    state = nullptr;
+    loops.clear();
+    return replaced;
+
+}
+
+void RangeAnalyzer::Walk(ASTStatement* node)
+{
+    if (node && state->reachable) node->Accept(*this);
+}
+
+RangeAnalyzer::RangeValue RangeAnalyzer::Analyze(std::unique_ptr<ASTExpression>& operand)
+{
+    bool parentEffects = effects;
+    effects = false;
+    operand->Accept(*this);
+    RangeValue result = value;
+
+    // A comparison with effects still has to run, even if its result is known.
+    if (record && !effects && operand->kind == ASTNodeKind::Comparison && result.range.IsConstant())
+    {
+        operand = ASTExpressionBool::Create(result.range.low != 0);
+        decidedComparisons++;
+        replaced = true;
+    }
+    effects |= parentEffects;
+    value = result;
+    return result;
+
+}
+
+RangeAnalyzer::RangeValue RangeAnalyzer::AnalyzeCondition(std::unique_ptr<ASTExpression>& condition)
+{
+    bool literal = condition->kind == ASTNodeKind::Bool;
+    RangeValue result = Analyze(condition);
+
+    // Conditions have to be bools, so other types are left for type checking to report.
+    if (!record || literal || result.kind != ValueKind::Bool || !result.range.IsConstant()) return result;
+    resolvedBranches++;
+    if (condition->kind != ASTNodeKind::Bool && !HasEffects(condition.get()))
+    {
+        condition = ASTExpressionBool::Create(result.range.low != 0);
+        replaced = true;
+    }
+    return result;
+
+}
+
+RangeAnalyzer::RangeValue RangeAnalyzer::EvaluatePure(ASTExpression* expr, RangeState& state)
+{
+    RangeState* parentState = this->state;
+    bool parentRecord = record;
+    bool parentEffects = effects;
+    this->state = &state;
+    record = false;
+    expr->Accept(*this);
+    this->state = parentState;
+    record = parentRecord;
+    effects = parentEffects;
+    return value;
+}
+
+void RangeAnalyzer::Assume(ASTExpression* condition, const RangeValue& range, bool outcome, RangeState& state)
+{
+    if (!state.reachable) return;
+    if (!Truth(range).Contains(outcome ? 1 : 0)) state.reachable = false;
+    else if (condition && !HasEffects(condition)) Refine(condition, outcome, state);
+}
+
+void RangeAnalyzer::Refine(ASTExpression* condition, bool outcome, RangeState& state)
+{
+    if (!state.reachable) return;
+    switch (condition->kind)
+    {
+
+        // The outcome that decides && or || comes either from the left operand, or from the right one after the left one did not decide it.
+        case ASTNodeKind::And:
+        case ASTNodeKind::Or:
+        {
+            auto binary = static_cast<ASTExpressionBinary*>(condition);
+            bool decider = condition->kind == ASTNodeKind::Or;
+            if (outcome != decider)
+            {
+                Refine(binary->a1.get(), outcome, state);
+                Refine(binary->a2.get(), outcome, state);
+                return;
+            }
+            RangeState rightDecided = state;
+            Refine(binary->a1.get(), decider, state);
+            Refine(binary->a1.get(), !decider, rightDecided);
+            Refine(binary->a2.get(), decider, rightDecided);
+            state.Join(rightDecided);
+            return;
+        }
+
+        // Variables compared are narrowed to the values that give the outcome.
+        case ASTNodeKind::Comparison:
+        {
+            auto comparison = static_cast<ASTExpressionComparison*>(condition);
+            RangeValue a = EvaluatePure(comparison->a1.get(), state);
+            RangeValue b = EvaluatePure(comparison->a2.get(), state);
+            if (a.kind == ValueKind::Other || b.kind == ValueKind::Other) return;
+            auto type = outcome ? comparison->type : Negate(comparison->type);
+            if (!Compare(type, a.range, b.range).Contains(1))
+            {
+                state.reachable = false;
+                return;
+            }
+            uint32_t var = RangedVariable(comparison->a1.get());
+            if (var != UINT32_MAX) state.ranges[var] = Restrict(type, state.ranges[var], b.range);
+            uint32_t other = RangedVariable(comparison->a2.get());
+            if (other != UINT32_MAX) state.ranges[other] = Restrict(Swap(type), state.ranges[other], a.range);
+            if ((var != UINT32_MAX && state.ranges[var].IsEmpty()) || (other != UINT32_MAX && state.ranges[other].IsEmpty())) state.reachable = false;
+            return;
+        }
+
+        // A variable used as a condition is 0 if false, and not 0 if true.
+        default:
+        {
+            if (!Truth(EvaluatePure(condition, state)).Contains(outcome ? 1 : 0))
+            {
+                state.reachable = false;
+                return;
+            }
+            uint32_t var = RangedVariable(condition);
+            if (var == UINT32_MAX) return;
+            Interval& range = state.ranges[var];
+            if (!outcome) range = range.Meet(Interval::Of(0));
+            else
+            {
+                if (range.low == 0) range.low = 1;
+                if (range.high == 0) range.high = -1;
+            }
+            if (range.IsEmpty()) state.reachable = false;
+            return;
+        }
+
+    }
+}
+
+template <typename WalkIteration>
+const RangeAnalyzer::RangeState& RangeAnalyzer::SolveLoop(const ASTStatement& loop, std::unique_ptr<ASTExpression>& condition, WalkIteration walkIteration)
+{
+    LoopState& loopState = loops[&loop];
+    if (loopState.solved && loopState.entry == *state && (loopState.iterated || solvingDepth >= MAX_SOLVED_DEPTH)) return loopState.head;
+    loopState.entry = *state;
+    loopState.solved = true;
+    loopState.head = *state;
+    RangeState& head = loopState.head;
+
+    // Every variable being anything is always a head that holds, just not a useful one.
+    loopState.iterated = solvingDepth < MAX_SOLVED_DEPTH;
+    if (!loopState.iterated)
+    {
+        for (uint32_t i = 0; i < head.ranges.size(); i++) head.ranges[i] = kinds[i] == ValueKind::Bool ? Interval::Bool() : Interval::Top();
+        return head;
+    }
+
+    // The head is the entry joined with the end of every iteration. Ranges found while iterating are not final, so nothing is replaced.
+    RangeState* parentState = state;
+    bool parentRecord = record;
+    record = false;
+    solvingDepth++;
+    auto iterate = [&]()
+    {
+        RangeState next = head;
+        state = &next;
+        RangeValue range = condition ? Analyze(condition) : RangeValue { Interval::Of(1), ValueKind::Bool };
+        Assume(condition.get(), range, true, next);
+        if (next.reachable) walkIteration();
+        next.Join(loopState.entry);
+        return next;
+    };
+
+    // Iterate until the head holds every value an iteration can bring back to it, widening so loops that count far stop soon.
+    for (int i = 0;; i++)
+    {
+        RangeState next = iterate();
+        if (head.Includes(next)) break;
+        if (i < WIDEN_DELAY) head.Join(next);
+        else head.Widen(next);
+    }
+
+    // Iterating again from a head that holds gives one that still holds, and takes back bounds widening sent to infinity.
+    for (int i = 0; i < NARROWINGS; i++)
+    {
+        if (!head.Narrow(iterate())) break;
+    }
+    solvingDepth--;
+    record = parentRecord;
+    state = parentState;
+    return head;
+
+}
+
+template <typename WalkIteration>
+int64_t RangeAnalyzer::WalkLoop(const ASTStatement& loop, std::unique_ptr<ASTExpression>& condition, const ASTStatement* step, WalkIteration walkIteration)
+{
+    RangeState entry;
+    if (record) entry = *state;
+    *state = SolveLoop(loop, condition, walkIteration);
+
+    // The loop exits from the head when the condition is false.
+    Induction induction = record ? FindInduction(condition.get(), *state) : Induction();
+    size_t assignments = induction.var != UINT32_MAX ? recordedAssignments[induction.var] : 0;
+    size_t returns = recordedReturns;
+    RangeValue range = condition ? AnalyzeCondition(condition) : RangeValue { Interval::Of(1), ValueKind::Bool };
+    RangeState exit = *state;
+    Assume(condition.get(), range, false, exit);
+    if (!record)
+    {
+        *state = std::move(exit);
+        return -1;
+    }
+
+    // With the head final, a single walk of an iteration decides everything in it.
+    Assume(condition.get(), range, true, *state);
+    if (state->reachable) walkIteration();
+
+    // The trip count is only known if an iteration always gets to its end, and the variable only changes by the step.
+    bool stepsOnce = induction.var != UINT32_MAX && state->reachable && recordedAssignments[induction.var] == assignments + 1 && recordedReturns == returns;
+    *state = std::move(exit);
+    return stepsOnce ? CountTrips(induction, step, entry) : -1;
+
+}
+
+RangeAnalyzer::Induction RangeAnalyzer::FindInduction(ASTExpression* condition, RangeState& head)
+{
+    if (!condition || condition->kind != ASTNodeKind::Comparison || HasEffects(condition)) return Induction();
+    auto comparison = static_cast<ASTExpressionComparison*>(condition);
+    Induction induction;
+    induction.type = comparison->type;
+    ASTExpression* bound = comparison->a2.get();
+    uint32_t var = RangedVariable(comparison->a1.get());
+    if (var == UINT32_MAX || kinds[var] != ValueKind::Int)
+    {
+        var = RangedVariable(comparison->a2.get());
+        if (var == UINT32_MAX || kinds[var] != ValueKind::Int) return Induction();
+        induction.type = Swap(comparison->type);
+        bound = comparison->a1.get();
+    }
+
+    // The bound is the same every iteration if it is a single value at the head.
+    RangeValue range = EvaluatePure(bound, head);
+    if (range.kind != ValueKind::Int || !range.range.IsConstant()) return Induction();
+    induction.var = var;
+    induction.bound = range.range.low;
+    return induction;
+
+}
+
+int64_t RangeAnalyzer::CountTrips(const Induction& induction, const ASTStatement* step, const RangeState& entry)
+{
+
+    // The step has to be the variable plus or minus a constant. In a block, it has to be one of the statements of the block itself, so it runs every iteration.
+    if (step && step->kind == ASTNodeKind::Block)
+    {
+        auto& statements = static_cast<const ASTStatementBlock*>(step)->statements;
+        auto found = std::find_if(statements.begin(), statements.end(), [&](auto& statement)
+        {
+            return statement->kind == ASTNodeKind::Assignment && RangedVariable(static_cast<const ASTExpressionAssignment*>(statement.get())->left.get()) == induction.var;
+        });
+        step = found == statements.end() ? nullptr : found->get();
+    }
+    if (!step || step->kind != ASTNodeKind::Assignment) return -1;
+    auto assignment = static_cast<const ASTExpressionAssignment*>(step);
+    if (RangedVariable(assignment->left.get()) != induction.var) return -1;
+    auto right = assignment->right.get();
+    if (right->kind != ASTNodeKind::Addition && right->kind != ASTNodeKind::Subtraction) return -1;
+    auto binary = static_cast<const ASTExpressionBinary*>(right);
+    int64_t stride;
+    if (RangedVariable(binary->a1.get()) == induction.var && binary->a2->kind == ASTNodeKind::Int) stride = static_cast<const ASTExpressionInt*>(binary->a2.get())->value;
+    else if (right->kind == ASTNodeKind::Addition && RangedVariable(binary->a2.get()) == induction.var && binary->a1->kind == ASTNodeKind::Int) stride = static_cast<const ASTExpressionInt*>(binary->a1.get())->value;
+    else return -1;
+    if (right->kind == ASTNodeKind::Subtraction) stride = -stride;
+
+    // Count the steps from the start until the comparison is false. Steps away from the bound never get there.
+    Interval start = entry.ranges[induction.var];
+    if (!entry.reachable || !start.IsConstant()) return -1;
+    int64_t from = start.low;
+    int64_t to = induction.bound;
+    int64_t trips;
+    switch (induction.type)
+    {
+        case LessThan:
+            if (from >= to) return 0;
+            if (stride <= 0) return -1;
+            trips = (to - from + stride - 1) / stride;
+            break;
+        case LessThanOrEqual:
+            if (from > to) return 0;
+            if (stride <= 0) return -1;
+            trips = (to - from) / stride + 1;
+            break;
+        case GreaterThan:
+            if (from <= to) return 0;
+            if (stride >= 0) return -1;
+            trips = (from - to - stride - 1) / -stride;
+            break;
+        case GreaterThanOrEqual:
+            if (from < to) return 0;
+            if (stride >= 0) return -1;
+            trips = (from - to) / -stride + 1;
+            break;
+        case Equal:
+            if (from != to) return 0;
+            if (stride == 0) return -1;
+            trips = 1;
+            break;
+        case NotEqual:
+            if (from == to) return 0;
+            if (stride == 0 || (to - from) % stride != 0 || (to - from) / stride < 0) return -1;
+            trips = (to - from) / stride;
+            break;
+        default:
+            return -1;
+    }
+
+    // The variable wraps around if the last step goes past the int limits, and then the count is wrong.
+    return Interval::Top().Contains(from + trips * stride) ? trips : -1;
+
+}
+
+uint32_t RangeAnalyzer::RangedVariable(const ASTExpression* expr) const
+{
+    if (!expr || expr->kind != ASTNodeKind::Variable) return UINT32_MAX;
+    auto found = indices.find(static_cast<const ASTExpressionVariable*>(expr)->var);
+    if (found == indices.end() || kinds[found->second] == ValueKind::Other) return UINT32_MAX;
+    return found->second;
+}
+
+Interval RangeAnalyzer::Truth(const RangeValue& value)
+{
+    switch (value.kind)
+    {
+        case ValueKind::Bool: return value.range;
+        case ValueKind::Int:
+            if (value.range == Interval::Of(0)) return Interval::Of(0);
+            return value.range.Contains(0) ? Interval::Bool() : Interval::Of(1);
+        default: return Interval::Bool();
+    }
+}
+
+Interval RangeAnalyzer::Compare(ASTExpressionComparisonType type, const Interval& a, const Interval& b)
+{
+    if (a.IsEmpty() || b.IsEmpty()) return Interval::Bool();
+    switch (type)
+    {
+        case Equal:
+            if (a.IsConstant() && a == b) return Interval::Of(1);
+            return a.high < b.low || b.high < a.low ? Interval::Of(0) : Interval::Bool();
+        case NotEqual:
+        {
+            Interval equal = Compare(Equal, a, b);
+            return Interval::Of(1 - equal.high, 1 - equal.low);
+        }
+        case LessThan:
+            if (a.high < b.low) return Interval::Of(1);
+            return a.low >= b.high ? Interval::Of(0) : Interval::Bool();
+        case LessThanOrEqual:
+            if (a.high <= b.low) return Interval::Of(1);
+            return a.low > b.high ? Interval::Of(0) : Interval::Bool();
+        case GreaterThan: return Compare(LessThan, b, a);
+        case GreaterThanOrEqual: return Compare(LessThanOrEqual, b, a);
+    }
+    return Interval::Bool();
+}
+
+Interval RangeAnalyzer::Restrict(ASTExpressionComparisonType type, const Interval& a, const Interval& b)
+{
+    switch (type)
+    {
+        case Equal: return a.Meet(b);
+        case LessThan: return Interval::Of(a.low, std::min(a.high, b.high - 1));
+        case LessThanOrEqual: return Interval::Of(a.low, std::min(a.high, b.high));
+        case GreaterThan: return Interval::Of(std::max(a.low, b.low + 1), a.high);
+        case GreaterThanOrEqual: return Interval::Of(std::max(a.low, b.low), a.high);
+
+        // Only a bound equal to a single value can be taken off, since ranges have no holes.
+        case NotEqual:
+        {
+            if (!b.IsConstant()) return a;
+            Interval restricted = a;
+            if (restricted.low == b.low) restricted.low++;
+            if (restricted.high == b.low) restricted.high--;
+            return restricted;
+        }
+    }
+    return a;
+}
+
+bool RangeAnalyzer::HasEffects(const ASTExpression* expr)
+{
+    switch (expr->kind)
+    {
+        case ASTNodeKind::Assignment:
+        case ASTNodeKind::Call:
+            return true;
+        case ASTNodeKind::Addition:
+        case ASTNodeKind::Subtraction:
+        case ASTNodeKind::Multiplication:
+        case ASTNodeKind::Division:
+        case ASTNodeKind::Comparison:
+        case ASTNodeKind::And:
+        case ASTNodeKind::Or:
+        {
+            auto binary = static_cast<const ASTExpressionBinary*>(expr);
+            return HasEffects(binary->a1.get()) || HasEffects(binary->a2.get());
+        }
+        case ASTNodeKind::Negation: return HasEffects(static_cast<const ASTExpressionNegation*>(expr)->operand.get());
+        case ASTNodeKind::Int2Float: return HasEffects(static_cast<const ASTExpressionInt2Float*>(expr)->operand.get());
+        case ASTNodeKind::Float2Int: return HasEffects(static_cast<const ASTExpressionFloat2Int*>(expr)->operand.get());
+        case ASTNodeKind::Int2Bool: return HasEffects(static_cast<const ASTExpressionInt2Bool*>(expr)->operand.get());
+        case ASTNodeKind::Bool2Int: return HasEffects(static_cast<const ASTExpressionBool2Int*>(expr)->operand.get());
+        default: return false;
+    }
+}
+
+void RangeAnalyzer::Visit(ASTStatementBlock& node)
+{
+    // Nothing after a return runs.
+    for (auto& statement : node.statements)
+    {
+        if (!state->reachable) break;
+        statement->Accept(*this);
+    }
+}
+
+void RangeAnalyzer::Visit(ASTStatementIf& node)
+{
+    // Each branch is walked with the ranges its outcome allows, and they meet again after the if.
+    RangeValue condition = AnalyzeCondition(node.condition);
+    RangeState elseState = *state;
+    Assume(node.condition.get(), condition, true, *state);
+    Assume(node.condition.get(), condition, false, elseState);
+    Walk(node.thenStatement.get());
+    RangeState* parentState = state;
+    state = &elseState;
+    Walk(node.elseStatement.get());
+    state = parentState;
+    state->Join(elseState);
+}
+
+void RangeAnalyzer::Visit(ASTStatementWhile& node)
+{
+    int64_t trips = WalkLoop(node, node.condition, node.thenStatement.get(), [&]()
+    {
+        Walk(node.thenStatement.get());
+    });
+    if (!record) return;
+    node.tripCount = trips;
+    if (trips >= 0) countedLoops++;
+}
+
+void RangeAnalyzer::Visit(ASTStatementFor& node)
+{
+    Walk(node.init.get());
+    if (!state->reachable) return;
+    int64_t trips = WalkLoop(node, node.condition, node.increment.get(), [&]()
+    {
+        Walk(node.body.get());
+        Walk(node.increment.get());
+    });
+    if (!record) return;
+    node.tripCount = trips;
+    if (trips >= 0) countedLoops++;
+}
+
+void RangeAnalyzer::Visit(ASTStatementReturn& node)
+{
+    if (node.returnExpression) Analyze(node.returnExpression);
+    if (record) recordedReturns++;
+    state->reachable = false;
+}
+
+void RangeAnalyzer::Visit(ASTExpressionInt& node)
+{
+    value = { Interval::Of(node.value), ValueKind::Int };
+}
+
+void RangeAnalyzer::Visit(ASTExpressionFloat& node)
+{
+    value = { Interval::Top(), ValueKind::Other };
+}
+
+void RangeAnalyzer::Visit(ASTExpressionBool& node)
+{
+    value = { Interval::Of(node.value ? 1 : 0), ValueKind::Bool };
+}
+
+void RangeAnalyzer::Visit(ASTExpressionString& node)
+{
+    value = { Interval::Top(), ValueKind::Other };
+}
+
+void RangeAnalyzer::Visit(ASTExpressionVariable& node)
+{
+    uint32_t var = RangedVariable(&node);
+    if (var == UINT32_MAX) value = { Interval::Top(), ValueKind::Other };
+    else value = { state->ranges[var], kinds[var] };
+}
+
+void RangeAnalyzer::Visit(ASTExpressionCall& node)
+{
+    for (auto& argument : node.arguments) Analyze(argument);
+    effects = true;
+    value = { Interval::Top(), ValueKind::Other };
+}
+
+void RangeAnalyzer::Visit(ASTExpressionAssignment& node)
+{
+    RangeValue right = Analyze(node.right);
+    effects = true;
+    uint32_t var = RangedVariable(node.left.get());
+    if (var == UINT32_MAX)
+    {
+        value = { Interval::Top(), ValueKind::Other };
+        return;
+    }
+
+    // The value is converted to the type of the variable. Floats converted to int can be anything.
+    Interval range;
+    if (kinds[var] == ValueKind::Bool) range = Truth(right);
+    else range = right.kind == ValueKind::Other ? Interval::Top() : right.range;
+    state->ranges[var] = range;
+    if (record) recordedAssignments[var]++;
+    value = { range, kinds[var] };
+
+}
+
+void RangeAnalyzer::Visit(ASTExpressionBinary& node)
+{
+    switch (node.kind)
+    {
+
+        // The right operand only runs if the left one does not decide the result, and then with the ranges that outcome of the left one allows.
+        case ASTNodeKind::And:
+        case ASTNodeKind::Or:
+        {
+            bool decider = node.kind == ASTNodeKind::Or;
+            RangeValue leftValue = Analyze(node.a1);
+            Interval left = Truth(leftValue);
+            if (left == Interval::Of(decider ? 1 : 0))
+            {
+                value = { left, ValueKind::Bool };
+                return;
+            }
+            RangeState rightState = *state;
+            Assume(node.a1.get(), leftValue, !decider, rightState);
+            RangeState* parentState = state;
+            state = &rightState;
+            Interval right = rightState.reachable ? Truth(Analyze(node.a2)) : Interval::Of(1, 0);
+            state = parentState;
+            if (left.IsConstant()) *state = std::move(rightState);
+            else state->Join(rightState);
+            value = { left.IsConstant() ? right : right.Join(Interval::Of(decider ? 1 : 0)), ValueKind::Bool };
+            return;
+        }
+
+        // Bools are compared as ints. Floats have no range.
+        case ASTNodeKind::Comparison:
+        {
+            RangeValue a = Analyze(node.a1);
+            RangeValue b = Analyze(node.a2);
+            bool ranged = a.kind != ValueKind::Other && b.kind != ValueKind::Other;
+            value = { ranged ? Compare(static_cast<ASTExpressionComparison&>(node).type, a.range, b.range) : Interval::Bool(), ValueKind::Bool };
+            return;
+        }
+
+        // Arithmetic is on ints only if both operands are ints. Bools are not allowed, and a float operand makes the result a float.
+        default:
+        {
+            RangeValue a = Analyze(node.a1);
+            RangeValue b = Analyze(node.a2);
+            value = { Interval::Top(), ValueKind::Other };
+            if (a.kind != ValueKind::Int || b.kind != ValueKind::Int) return;
+            Interval x = a.range;
+            Interval y = b.range;
+            value.kind = ValueKind::Int;
+            switch (node.kind)
+            {
+                case ASTNodeKind::Addition: value.range = Interval::Of(x.low + y.low, x.high + y.high).Wrap(); break;
+                case ASTNodeKind::Subtraction: value.range = Interval::Of(x.low - y.high, x.high - y.low).Wrap(); break;
+                case ASTNodeKind::Multiplication:
+                {
+                    int64_t products[] = { x.low * y.low, x.low * y.high, x.high * y.low, x.high * y.high };
+                    value.range = Interval::Of(*std::min_element(products, products + 4), *std::max_element(products, products + 4)).Wrap();
+                    break;
+                }
+
+                // Division truncates toward zero, which is monotonic in each operand on either side of a zero divisor. Dividing by zero is undefined, so it is left out.
+                case ASTNodeKind::Division:
+                {
+                    Interval result = Interval::Of(1, 0);
+                    for (Interval divisor : { y.Meet(Interval::Of(INT_MIN, -1)), y.Meet(Interval::Of(1, INT_MAX)) })
+                    {
+                        if (divisor.IsEmpty()) continue;
+                        int64_t quotients[] = { x.low / divisor.low, x.low / divisor.high, x.high / divisor.low, x.high / divisor.high };
+                        result = result.Join(Interval::Of(*std::min_element(quotients, quotients + 4), *std::max_element(quotients, quotients + 4)));
+                    }
+                    value.range = result.IsEmpty() ? Interval::Top() : result.Wrap();
+                    break;
+                }
+
+                default: value.range = Interval::Top(); break;
+            }
+            return;
+        }
+
+    }
+}
+
+void RangeAnalyzer::Visit(ASTExpressionNegation& node)
+{
+    RangeValue operand = Analyze(node.operand);
+    if (operand.kind == ValueKind::Int) value = { Interval::Of(-operand.range.high, -operand.range.low).Wrap(), ValueKind::Int };
+    else value = { Interval::Top(), ValueKind::Other };
+}
+
+void RangeAnalyzer::Visit(ASTExpressionInt2Float& node)
+{
+    Analyze(node.operand);
+    value = { Interval::Top(), ValueKind::Other };
+}
+
+void RangeAnalyzer::Visit(ASTExpressionFloat2Int& node)
+{
+    Analyze(node.operand);
+    value = { Interval::Top(), ValueKind::Int };
+}
+
+void RangeAnalyzer::Visit(ASTExpressionInt2Bool& node)
+{
+    value = { Truth(Analyze(node.operand)), ValueKind::Bool };
+}
+
+void RangeAnalyzer::Visit(ASTExpressionBool2Int& node)
+{
+    value = { Analyze(node.operand).range, ValueKind::Int };
+}
@@ -0,0 +1,324 @@
+#pragma once
+
+#include "expression.h"
+#include "symbol.h"
+#include "expressions/comparison.h"
+#include "visitor.h"
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// A range of values an int can have. Bools are ranges within 0 and 1, like the ints they convert to.
+// Bounds are stored wider than an int, so results can be computed without overflowing before they are checked. The int limits double as infinity.
+struct Interval
+{
+
+    // Lowest and highest value. The range is empty if the low bound is above the high one.
+    int64_t low;
+    int64_t high;
+
+    // Create a range.
+    // low: Lowest value.
+    // high: Highest value.
+    static Interval Of(int64_t low, int64_t high) { return Interval { low, high }; }
+
+    // Create a range of a single value.
+    // value: The value.
+    static Interval Of(int64_t value) { return Interval { value, value }; }
+
+    // Create a range of every int.
+    static Interval Top() { return Interval { INT_MIN, INT_MAX }; }
+
+    // Create a range of both bool values.
+    static Interval Bool() { return Interval { 0, 1 }; }
+
+    // If there is no value in the range.
+    bool IsEmpty() const { return low > high; }
+
+    // If there is a single value in the range.
+    bool IsConstant() const { return low == high; }
+
+    // If a value is in the range.
+    // value: Value to check.
+    bool Contains(int64_t value) const { return low <= value && value <= high; }
+
+    // If every value of another range is in this one.
+    // other: Range to check.
+    bool Includes(const Interval& other) const { return other.IsEmpty() || (low <= other.low && other.high <= high); }
+
+    // Get the smallest range holding the values of both ranges.
+    // other: Range to join with.
+    Interval Join(const Interval& other) const;
+
+    // Get the range of the values in both ranges.
+    // other: Range to meet with.
+    Interval Meet(const Interval& other) const;
+
+    // Join with the range found by the next loop iteration, sending every bound that grew to infinity so loops are solved in a few iterations.
+    // next: Range found by the next iteration.
+    Interval Widen(const Interval& next) const;
+
+    // Take back infinite bounds from widening where the next loop iteration found finite ones. The next range must be within this one.
+    // next: Range found by the next iteration.
+    Interval Narrow(const Interval& next) const;
+
+    // Get the range of an int result, which is every int if it could wrap around.
+    Interval Wrap() const { return low < INT_MIN || high > INT_MAX ? Top() : *this; }
+
+    bool operator==(const Interval& other) const { return low == other.low && high == other.high; }
+    bool operator!=(const Interval& other) const { return !(*this == other); }
+
+};
+
+// Finds the range of every int and bool variable at each point of a function by abstract interpretation, and decides the comparisons the ranges settle.
+// Branches are followed with the ranges their condition allows, and loops are solved by widening the ranges at their head until they stop changing, then narrowing them back with more iterations.
+// For example, after i = 0; while (i < 10000) i = i + 1; the range of i is exactly 10000, so a later i > 0 is always true. Comparisons like that are replaced by literals for constant folding to prune.
+// The number of times a loop runs is also found when it counts a variable up or down to a bound by a constant step, and kept in the loop node for later passes.
+class RangeAnalyzer : public ASTMutator
+{
+
+    // What kind of value an expression has, as far as ranges go. Other values like floats and strings have no range.
+    enum class ValueKind : uint8_t
+    {
+        Int,
+        Bool,
+        Other
+    };
+
+    // Range and kind of the value of an expression.
+    struct RangeValue
+    {
+        Interval range;
+        ValueKind kind;
+    };
+
+    // Ranges of every variable at a point in the function.
+    struct RangeState
+    {
+
+        // If the point can be reached at all. Ranges are meaningless if not.
+        bool reachable = true;
+
+        // Range of each variable, by number. Variables with no range are every int.
+        std::vector<Interval> ranges;
+
+        // Add the values of another state, for where two paths meet.
+        // other: State of the other path.
+        void Join(const RangeState& other);
+
+        // Widen with the state found by the next loop iteration, see Interval::Widen.
+        // next: State found by the next iteration.
+        void Widen(const RangeState& next);
+
+        // Narrow with the state found by the next loop iteration, see Interval::Narrow.
+        // next: State found by the next iteration.
+        // Returns: If any range changed.
+        bool Narrow(const RangeState& next);
+
+        // If every value of another state is in this one.
+        // other: State to check.
+        bool Includes(const RangeState& other) const;
+
+        bool operator==(const RangeState& other) const { return reachable == other.reachable && ranges == other.ranges; }
+
+    };
+
+    // What is known about a loop so far. It is kept across walks of the code around the loop, so a nested loop is not solved again if the ranges entering it did not change.
+    struct LoopState
+    {
+
+        // Ranges entering the loop that the head was last found for.
+        RangeState entry;
+
+        // Ranges at the head of the loop, before the condition, for entry.
+        RangeState head;
+
+        // If the head has been found at all yet.
+        bool solved = false;
+
+        // If the head was found by iterating the loop, rather than taken to be anything because the loop was nested too deep.
+        bool iterated = false;
+
+    };
+
+    // A variable a loop condition compares to a bound that does not change while the loop runs, like i < 10.
+    struct Induction
+    {
+
+        // Number of the variable, or UINT32_MAX if the condition is not like that.
+        uint32_t var = UINT32_MAX;
+
+        // Comparison of the variable to the bound, with the variable on the left.
+        ASTExpressionComparisonType type;
+
+        // Value of the bound.
+        int64_t bound;
+
+    };
+
+    // Iterations of a loop before its ranges are widened, so loops that settle quickly keep exact ranges.
+    static constexpr int WIDEN_DELAY = 2;
+
+    // Most narrowing iterations of a loop.
+    static constexpr int NARROWINGS = 3;
+
+    // Loops nested deeper than this inside loops being solved start from a head where every variable can be anything, instead of being solved each time the loops around them iterate, which would take exponential time.
+    static constexpr size_t MAX_SOLVED_DEPTH = 3;
+
+    // Number of each variable of the function being analyzed. Variables not in here, like undeclared ones, have no range.
+    std::unordered_map<Symbol, uint32_t> indices;
+
+    // Kind of value of each variable.
+    std::vector<ValueKind> kinds;
+
+    // Ranges at the node being visited.
+    RangeState* state = nullptr;
+
+    // State of every loop walked so far.
+    std::unordered_map<const ASTStatement*, LoopState> loops;
+
+    // Number of loops being solved around the node being visited.
+    size_t solvingDepth = 0;
+
+    // If ranges are final, so comparisons they decide are replaced. They are not while loops are being solved.
+    bool record = true;
+
+    // Value of the expression visited last, and if it or anything in it had effects.
+    RangeValue value = { Interval::Top(), ValueKind::Other };
+    bool effects = false;
+
+    // Number of assignments to each variable and returns walked with final ranges so far, to find the ones inside a loop.
+    std::vector<size_t> recordedAssignments;
+    size_t recordedReturns = 0;
+
+    // If any node was replaced in the function being analyzed.
+    bool replaced = false;
+
+    // Walk a statement with the current state, if it can be reached.
+    // node: Statement to walk. May be null.
+    void Walk(ASTStatement* node);
+
+    // Find the range of an operand, and replace it with a literal if it is a comparison with final ranges that decide it.
+    // operand: Operand to analyze.
+    // Returns: Range of the operand.
+    RangeValue Analyze(std::unique_ptr<ASTExpression>& operand);
+
+    // Find the range of the condition of a branch or loop, and replace the whole condition with a literal if final ranges decide it.
+    // condition: Condition to analyze.
+    // Returns: Range of the condition.
+    RangeValue AnalyzeCondition(std::unique_ptr<ASTExpression>& condition);
+
+    // Find the range of an expression with no effects in a state without replacing anything.
+    // expr: Expression to evaluate.
+    // state: State to evaluate in.
+    // Returns: Range of the expression.
+    RangeValue EvaluatePure(ASTExpression* expr, RangeState& state);
+
+    // Narrow a state to the ranges where a condition has an outcome. Only the range of the condition is used if it has effects.
+    // condition: Condition that was checked. May be null for a condition that is always true.
+    // range: Range of the condition.
+    // outcome: Outcome of the condition.
+    // state: State after checking the condition, which is narrowed.
+    void Assume(ASTExpression* condition, const RangeValue& range, bool outcome, RangeState& state);
+
+    // Narrow a state to the ranges where a condition with no effects has an outcome.
+    // condition: Condition that was checked.
+    // outcome: Outcome of the condition.
+    // state: State after checking the condition, which is narrowed.
+    void Refine(ASTExpression* condition, bool outcome, RangeState& state);
+
+    // Find the head of a loop, iterating it until the ranges stop changing.
+    // loop: The loop.
+    // condition: Condition of the loop. May be null for a loop that only ends by returning.
+    // walkIteration: Walks an iteration of the loop after the condition, given its state.
+    // Returns: Ranges at the head of the loop.
+    template <typename WalkIteration>
+    const RangeState& SolveLoop(const ASTStatement& loop, std::unique_ptr<ASTExpression>& condition, WalkIteration walkIteration);
+
+    // Walk a loop: solve its head, then walk an iteration with final ranges if they are, and leave the state of the exit.
+    // loop: The loop.
+    // condition: Condition of the loop. May be null for a loop that only ends by returning.
+    // step: Statement that runs once every iteration and may step the variable of the loop, or a block of them. May be null.
+    // walkIteration: Walks an iteration of the loop after the condition.
+    // Returns: Number of iterations, or -1 if it can't be known or ranges are not final.
+    template <typename WalkIteration>
+    int64_t WalkLoop(const ASTStatement& loop, std::unique_ptr<ASTExpression>& condition, const ASTStatement* step, WalkIteration walkIteration);
+
+    // Find the variable a loop condition compares to a fixed bound.
+    // condition: Condition of the loop. May be null.
+    // head: Ranges at the head of the loop.
+    // Returns: The variable and bound, or no variable.
+    Induction FindInduction(ASTExpression* condition, RangeState& head);
+
+    // Find how many times a loop runs from the step its variable is changed by in each iteration.
+    // induction: Variable of the loop and its bound.
+    // step: Assignment to the variable that runs once every iteration, or a block with it as one of its statements. May be another statement, in which case the count can't be known.
+    // entry: Ranges entering the loop.
+    // Returns: Number of iterations, or -1 if it can't be known.
+    int64_t CountTrips(const Induction& induction, const ASTStatement* step, const RangeState& entry);
+
+    // Get the number of a variable node with a range.
+    // expr: Expression to check. May be null.
+    // Returns: The number of the variable, or UINT32_MAX if the expression is not a variable with a range.
+    uint32_t RangedVariable(const ASTExpression* expr) const;
+
+    // Range of the bool a value converts to.
+    // value: Value to convert.
+    static Interval Truth(const RangeValue& value);
+
+    // Range of a comparison of two ranges, which is a single bool when the ranges decide it.
+    // type: Type of comparison.
+    // a: Range of the left operand.
+    // b: Range of the right operand.
+    static Interval Compare(ASTExpressionComparisonType type, const Interval& a, const Interval& b);
+
+    // Narrow the range of the left operand of a comparison to the values that can make it true.
+    // type: Type of comparison.
+    // a: Range of the left operand.
+    // b: Range of the right operand.
+    // Returns: The values of the left range that are true for some value of the right one.
+    static Interval Restrict(ASTExpressionComparisonType type, const Interval& a, const Interval& b);
+
+    // If an expression has effects, like an assignment or call.
+    // expr: Expression to check.
+    static bool HasEffects(const ASTExpression* expr);
+
+public:
+
+    // Number of comparisons replaced by literals so far.
+    size_t decidedComparisons = 0;
+
+    // Number of branch and loop conditions found to always go the same way so far.
+    size_t resolvedBranches = 0;
+
+    // Number of loops whose trip count was found so far.
+    size_t countedLoops = 0;
+
+    // Find ranges in the body of a function, replace the comparisons they decide, and set the trip count of its loops.
+    // function: Function to analyze. May be only declared.
+    // Returns: If any comparison or condition was replaced.
+    bool AnalyzeFunction(ASTFunction& function);
+
+    // Virtual functions. See base class for details.
+    void Visit(ASTStatementBlock& node) override;
+    void Visit(ASTStatementIf& node) override;
+    void Visit(ASTStatementWhile& node) override;
+    void Visit(ASTStatementFor& node) override;
+    void Visit(ASTStatementReturn& node) override;
+    void Visit(ASTExpressionInt& node) override;
+    void Visit(ASTExpressionFloat& node) override;
+    void Visit(ASTExpressionBool& node) override;
+    void Visit(ASTExpressionString& node) override;
+    void Visit(ASTExpressionVariable& node) override;
+    void Visit(ASTExpressionCall& node) override;
+    void Visit(ASTExpressionAssignment& node) override;
+    void Visit(ASTExpressionBinary& node) override;
+    void Visit(ASTExpressionNegation& node) override;
+    void Visit(ASTExpressionInt2Float& node) override;
+    void Visit(ASTExpressionFloat2Int& node) override;
+    void Visit(ASTExpressionInt2Bool& node) override;
+    void Visit(ASTExpressionBool2Int& node) override;
+
+};
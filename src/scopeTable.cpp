@@ -1,31 +1,30 @@
 #include "scopeTable.h"
 
-bool ScopeTable::AddVariable(const std::string& name, std::unique_ptr<VarType> type, llvm::Value* value)
+bool ScopeTable::AddVariable(Symbol name, const VarType* type, llvm::Value* value)
 {
-    if (types.find(name) == types.end()) // This is true if name doesn't exist in map.
+    if (types.try_emplace(name, type).second) // This is only true if name didn't exist in map.
     {
-        types[name] = std::move(type);
         values[name] = value;
         return true; // We added a variable as expected.
     }
     else return false; // Variable already exists!
 }
 
-VarType* ScopeTable::GetVariableType(const std::string& name)
+const VarType* ScopeTable::GetVariableType(Symbol name)
 {
     auto foundType = types.find(name);
     if (foundType == types.end()) return nullptr; // Variable doesn't exist, return null.
-    else return foundType->second.get(); // Variable exists, return pointer to type.
+    else return foundType->second; // Variable exists, return pointer to type.
 }
 
-llvm::Value* ScopeTable::GetVariableValue(const std::string& name)
+llvm::Value* ScopeTable::GetVariableValue(Symbol name)
 {
     auto foundType = values.find(name);
     if (foundType == values.end()) return nullptr; // Variable doesn't exist, return null.
     else return foundType->second; // Variable exists, return value.
 }
 
-bool ScopeTable::SetVariableValue(const std::string& name, llvm::Value* value)
+bool ScopeTable::SetVariableValue(Symbol name, llvm::Value* value)
 {
     auto foundType = values.find(name);
     if (foundType == values.end()) return false; // Variable doesn't exist, return false.
@@ -0,0 +1,245 @@
+#include "server.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <system_error>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+ServerConnection::~ServerConnection()
+{
+    fclose(in);
+    if (out != fileno(stdout)) close(out);
+}
+
+Server::Server(unsigned threads)
+{
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threads; i++) workers.emplace_back(&Server::WorkerLoop, this);
+}
+
+Server::~Server()
+{
+
+    // Cut the clients off so their readers see the end of the stream. Only the reading side is shut, so the requests they already sent are still answered.
+    std::list<ServerReader> stopped;
+    {
+        std::lock_guard<std::mutex> lock(readersMutex);
+        for (auto& reader : readers)
+        {
+            if (auto connection = reader.connection.lock()) shutdown(fileno(connection->in), SHUT_RD);
+        }
+        stopped.splice(stopped.end(), readers); // Joined without the lock, which the readers take to mark themselves done.
+    }
+    for (auto& reader : stopped) reader.thread.join();
+
+    // Then let the workers finish.
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        stopping = true;
+    }
+    jobsChanged.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void Server::WorkerLoop()
+{
+    while (true)
+    {
+
+        // Wait for a job.
+        std::unique_lock<std::mutex> lock(jobsMutex);
+        jobsChanged.wait(lock, [&]() { return !jobs.empty() || stopping; });
+        if (jobs.empty()) return; // Stopping and nothing left to do.
+        ServerJob job = std::move(jobs.front());
+        jobs.pop_front();
+        lock.unlock();
+
+        // Requests are already compiled concurrently, so each one only gets a single thread.
+        job.options.threads = 1;
+        WriteResult(*job.connection, job.id, CompileSource(job.source, job.options));
+
+    }
+}
+
+void Server::ReadRequests(std::shared_ptr<ServerConnection> connection)
+{
+    char header[256];
+    while (fgets(header, sizeof(header), connection->in))
+    {
+
+        // Parse the header. The length is read signed so a negative one is rejected instead of wrapping around to a huge size.
+        char id[128], format[16];
+        int printAst;
+        long long length;
+        if (sscanf(header, "COMPILE %127s %15s %d %lld", id, format, &printAst, &length) != 4 || length < 0)
+        {
+            WriteFailure(*connection, "-", "ERROR: Invalid request header, expected COMPILE <id> <asm|bc|ast|astbin|none> <0|1> <length>.\n");
+            return; // The source of the request can't be skipped without a valid header, so nothing after it can be read.
+        }
+        ServerJob job;
+        job.connection = connection;
+        job.id = id;
+        job.options.printAst = printAst != 0;
+        bool validFormat = true;
+        if (strcmp(format, "asm") == 0) job.options.format = CompileFormat::Assembly;
+        else if (strcmp(format, "bc") == 0) job.options.format = CompileFormat::Bitcode;
+        else if (strcmp(format, "ast") == 0) job.options.format = CompileFormat::Ast;
+        else if (strcmp(format, "astbin") == 0) job.options.format = CompileFormat::AstBinary;
+        else if (strcmp(format, "none") == 0) job.options.format = CompileFormat::None;
+        else validFormat = false;
+        if (!validFormat)
+        {
+            WriteFailure(*connection, job.id, "ERROR: Unknown output format " + std::string(format) + ", expected asm, bc, ast, astbin, or none.\n");
+            if (!SkipSource(*connection, length)) return;
+            continue;
+        }
+
+        // Read the source. Sources too big to hold are skipped, so the requests after them can still be read.
+        bool tooLarge = (unsigned long long)length > SERVER_MAX_SOURCE_SIZE;
+        if (!tooLarge)
+        {
+            try
+            {
+                job.source.resize((size_t)length);
+            }
+            catch (const std::bad_alloc&)
+            {
+                tooLarge = true;
+            }
+        }
+        if (tooLarge)
+        {
+            WriteFailure(*connection, job.id, "ERROR: Request source of " + std::to_string(length) + " bytes is too large, at most " + std::to_string(SERVER_MAX_SOURCE_SIZE) + " are allowed.\n");
+            if (!SkipSource(*connection, length)) return;
+            continue;
+        }
+        if (fread(job.source.data(), 1, job.source.size(), connection->in) != job.source.size()) return; // Closed in the middle of a request.
+
+        // Queue it up.
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex);
+            jobs.push_back(std::move(job));
+        }
+        jobsChanged.notify_one();
+
+    }
+}
+
+void Server::JoinFinishedReaders()
+{
+    std::lock_guard<std::mutex> lock(readersMutex);
+    for (auto reader = readers.begin(); reader != readers.end();)
+    {
+        if (!reader->done)
+        {
+            reader++;
+            continue;
+        }
+        reader->thread.join(); // Only has to return after marking itself done.
+        reader = readers.erase(reader);
+    }
+}
+
+bool Server::SkipSource(ServerConnection& connection, long long length)
+{
+    char skipped[4096];
+    for (long long left = length; left > 0;)
+    {
+        size_t count = fread(skipped, 1, (size_t)std::min<long long>(left, sizeof(skipped)), connection.in);
+        if (count == 0) return false;
+        left -= (long long)count;
+    }
+    return true;
+}
+
+void Server::WriteFailure(ServerConnection& connection, const std::string& id, const std::string& message)
+{
+    CompileResult result;
+    result.diagnostics = message;
+    WriteResult(connection, id, result);
+}
+
+void Server::WriteResult(ServerConnection& connection, const std::string& id, const CompileResult& result)
+{
+    std::string answer = "RESULT " + id + (result.success ? " OK " : " FAIL ") + std::to_string(result.output.size()) + " " + std::to_string(result.ast.size()) + " " + std::to_string(result.diagnostics.size()) + "\n";
+    answer += result.output;
+    answer += result.ast;
+    answer += result.diagnostics;
+
+    // Write it all at once so answers from different workers don't interleave.
+    std::lock_guard<std::mutex> lock(connection.writeMutex);
+    for (size_t written = 0; written < answer.size();)
+    {
+        ssize_t count = write(connection.out, answer.data() + written, answer.size() - written);
+        if (count <= 0) return; // The client went away, nobody is left to answer.
+        written += (size_t)count;
+    }
+}
+
+void Server::ServeStdio()
+{
+    ReadRequests(std::make_shared<ServerConnection>(stdin, fileno(stdout)));
+}
+
+bool Server::ServeSocket(const std::string& path)
+{
+
+    // Create the socket.
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) return false;
+    strcpy(address.sun_path, path.c_str());
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) return false;
+    unlink(path.c_str());
+    if (bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0)
+    {
+        close(listener);
+        return false;
+    }
+    signal(SIGPIPE, SIG_IGN); // Clients that go away should not take the server with them.
+
+    // Read from every client on a thread of its own, joining the threads of clients that left as new ones come. The workers do the compiling.
+    while (true)
+    {
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0)
+        {
+            if (errno == EINTR) continue;
+            close(listener);
+            return false;
+        }
+        int readEnd = dup(client);
+        FILE* in = readEnd >= 0 ? fdopen(readEnd, "r") : nullptr;
+        if (!in)
+        {
+            // Out of descriptors or memory. Drop this client but keep serving the others.
+            if (readEnd >= 0) close(readEnd);
+            close(client);
+            continue;
+        }
+        auto connection = std::make_shared<ServerConnection>(in, client);
+        JoinFinishedReaders();
+        std::lock_guard<std::mutex> lock(readersMutex);
+        ServerReader& reader = readers.emplace_back();
+        reader.connection = connection;
+        try
+        {
+            reader.thread = std::thread([this, connection, &reader]()
+            {
+                ReadRequests(connection);
+                std::lock_guard<std::mutex> lock(readersMutex);
+                reader.done = true;
+            });
+        }
+        catch (const std::system_error&)
+        {
+            readers.pop_back(); // Out of threads. Drop this client like above.
+        }
+    }
+
+}
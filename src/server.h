@@ -0,0 +1,159 @@
+#pragma once
+
+#include "compiler.h"
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+    The server keeps the compiler running to answer many compile requests, so process startup, LLVM's one-time setup, and starting threads are only paid once.
+    What stays per request is the LLVM context, module, and pass manager of the request's AST, since a context keeps every type and constant ever made in it and would grow without bound if shared.
+    For a small function that is about a tenth of the half millisecond a request takes, against about 20 milliseconds for starting the compiler for it.
+    Requests come in over connections: standard in and out, or clients of a Unix domain socket. Each request is a header line followed by the source:
+        COMPILE <id> <asm|bc|ast|astbin|none> <print AST: 0|1> <source length>\n<source>
+    Requests are compiled concurrently on a pool of workers, so answers may come back out of order. The id, any word, tells them apart:
+        RESULT <id> <OK|FAIL> <output length> <AST length> <diagnostics length>\n<output><AST><diagnostics>
+    Sources longer than SERVER_MAX_SOURCE_SIZE and requests for an unknown format are skipped and answered with a FAIL.
+*/
+
+// Longest source a request may have. Longer ones are refused instead of read into memory.
+constexpr size_t SERVER_MAX_SOURCE_SIZE = 256 * 1024 * 1024;
+
+// A client of the server. Answers are written to it as its requests finish.
+struct ServerConnection
+{
+
+    // Stream requests are read from.
+    FILE* in;
+
+    // File descriptor answers are written to.
+    int out;
+
+    // Answers are written from many workers, so only one may write at a time.
+    std::mutex writeMutex;
+
+    // Create a new connection. It takes ownership of both ends.
+    // in: Stream requests are read from.
+    // out: File descriptor answers are written to.
+    ServerConnection(FILE* in, int out) : in(in), out(out) {}
+
+    // Close both ends.
+    ~ServerConnection();
+
+};
+
+// A thread reading requests from a client of the socket.
+struct ServerReader
+{
+
+    // Thread running the reads.
+    std::thread thread;
+
+    // Connection it reads from. Not kept alive by this, it closes as soon as its last request is answered.
+    std::weak_ptr<ServerConnection> connection;
+
+    // Set by the thread once it is done reading, so it can be joined without waiting.
+    bool done = false;
+
+};
+
+// A compile request waiting for a worker.
+struct ServerJob
+{
+
+    // Connection to answer on. Shared, so it stays open until every request on it has been answered.
+    std::shared_ptr<ServerConnection> connection;
+
+    // Id to answer with.
+    std::string id;
+
+    // Source to compile.
+    std::string source;
+
+    // Options to compile with.
+    CompileOptions options;
+
+};
+
+// Compile server, see above for the protocol.
+class Server
+{
+
+    // Workers that compile requests.
+    std::vector<std::thread> workers;
+
+    // Requests waiting for a worker, in the order they came in.
+    std::deque<ServerJob> jobs;
+
+    // Guards the jobs and stopping flag.
+    std::mutex jobsMutex;
+
+    // Signaled when a job is added or the server stops.
+    std::condition_variable jobsChanged;
+
+    // Set once no more jobs will come in. Workers finish the remaining jobs, then exit.
+    bool stopping = false;
+
+    // Threads reading from socket clients. They queue jobs on the server, so they must be done before it goes away. A list, so each thread can mark its own entry done while others are added.
+    std::list<ServerReader> readers;
+
+    // Guards the readers.
+    std::mutex readersMutex;
+
+    // Join the readers that are done reading.
+    void JoinFinishedReaders();
+
+    // Take jobs and compile them until the server stops.
+    void WorkerLoop();
+
+    // Read requests from a connection and queue them until it is closed or sends something invalid.
+    // connection: Connection to read from.
+    void ReadRequests(std::shared_ptr<ServerConnection> connection);
+
+    // Read past the source of a request that is not compiled.
+    // connection: Connection to read from.
+    // length: Length of the source.
+    // Returns: If the whole source was read, false if the connection closed first.
+    static bool SkipSource(ServerConnection& connection, long long length);
+
+    // Answer a request that could not be compiled.
+    // connection: Connection to write to.
+    // id: Id of the request being answered.
+    // message: Why the request failed.
+    static void WriteFailure(ServerConnection& connection, const std::string& id, const std::string& message);
+
+    // Send an answer on a connection.
+    // connection: Connection to write to.
+    // id: Id of the request being answered.
+    // result: Result of compiling the request.
+    static void WriteResult(ServerConnection& connection, const std::string& id, const CompileResult& result);
+
+public:
+
+    // Create a server and start its workers.
+    // threads: Number of requests to compile at once. 0 uses one per hardware thread.
+    Server(unsigned threads = 0);
+
+    // The workers reference the server, so it can't be copied or moved.
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Stop reading from socket clients, answer all queued requests, then stop the workers.
+    ~Server();
+
+    // Serve requests from standard in, answering on standard out.
+    // Returns once standard in is closed.
+    void ServeStdio();
+
+    // Listen on a Unix domain socket and serve every client that connects, each on its own connection.
+    // path: Path of the socket to create. Anything already there is replaced.
+    // Returns: Only returns on failure, with false.
+    bool ServeSocket(const std::string& path);
+
+};
@@ -0,0 +1,257 @@
+#include "ssa.h"
+
+DominatorTree::DominatorTree(const CFG& cfg) : order(cfg.ReversePostorder()), idom(cfg.blocks.size(), CFG_NONE), children(cfg.blocks.size()), frontiers(cfg.blocks.size())
+{
+
+    // Walk up from two blocks until they meet, always moving the one later in reverse postorder. The entry is its own dominator while this runs.
+    std::vector<uint32_t> position(cfg.blocks.size(), UINT32_MAX);
+    for (uint32_t i = 0; i < order.size(); i++) position[order[i]] = i;
+    auto intersect = [&](CFGBlockId a, CFGBlockId b)
+    {
+        while (a != b)
+        {
+            while (position[a] > position[b]) a = idom[a];
+            while (position[b] > position[a]) b = idom[b];
+        }
+        return a;
+    };
+
+    // Refine the dominators in reverse postorder until they stop changing, which only takes a few passes unless loops are nested deep.
+    idom[CFG::ENTRY] = CFG::ENTRY;
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (size_t i = 1; i < order.size(); i++)
+        {
+            CFGBlockId block = order[i];
+            CFGBlockId newIdom = CFG_NONE;
+            for (CFGBlockId pred : cfg.blocks[block].predecessors)
+            {
+                if (idom[pred] == CFG_NONE) continue; // Not processed yet, or unreachable.
+                newIdom = newIdom == CFG_NONE ? pred : intersect(pred, newIdom);
+            }
+            if (idom[block] != newIdom)
+            {
+                idom[block] = newIdom;
+                changed = true;
+            }
+        }
+    }
+    idom[CFG::ENTRY] = CFG_NONE;
+    for (size_t i = 1; i < order.size(); i++) children[idom[order[i]]].push_back(order[i]);
+
+    // A block is in the frontier of everything between each of its predecessors and its immediate dominator.
+    for (CFGBlockId block : order)
+    {
+        auto& preds = cfg.blocks[block].predecessors;
+        if (preds.size() < 2) continue;
+        for (CFGBlockId pred : preds)
+        {
+            if (!IsReachable(pred)) continue;
+            for (CFGBlockId runner = pred; runner != idom[block]; runner = idom[runner])
+            {
+                if (frontiers[runner].empty() || frontiers[runner].back() != block) frontiers[runner].push_back(block);
+            }
+        }
+    }
+
+    // Number the tree in preorder and postorder with an explicit stack, so deep trees can't overflow the call stack.
+    preorder.assign(cfg.blocks.size(), UINT32_MAX);
+    postorder.assign(cfg.blocks.size(), UINT32_MAX);
+    uint32_t nextPre = 0, nextPost = 0;
+    std::vector<std::pair<CFGBlockId, size_t>> stack = { { CFG::ENTRY, 0 } };
+    preorder[CFG::ENTRY] = nextPre++;
+    while (!stack.empty())
+    {
+        auto& [block, next] = stack.back();
+        if (next < children[block].size())
+        {
+            CFGBlockId child = children[block][next++];
+            preorder[child] = nextPre++;
+            stack.push_back({ child, 0 });
+        }
+        else
+        {
+            postorder[block] = nextPost++;
+            stack.pop_back();
+        }
+    }
+
+}
+
+bool DominatorTree::Dominates(CFGBlockId a, CFGBlockId b) const
+{
+    if (!IsReachable(a) || !IsReachable(b)) return false;
+    return preorder[a] <= preorder[b] && postorder[b] <= postorder[a];
+}
+
+std::vector<CFGLoop> DominatorTree::FindLoops(const CFG& cfg) const
+{
+    std::vector<CFGLoop> loops;
+    std::vector<CFGBlockId> inLoop(cfg.blocks.size(), CFG_NONE); // Head of the last loop each block was added to.
+    for (CFGBlockId head : order) // Outer heads come first in reverse postorder.
+    {
+        CFGLoop loop;
+        loop.head = head;
+        loop.node = cfg.blocks[head].loop;
+        for (CFGBlockId pred : cfg.blocks[head].predecessors)
+        {
+            if (Dominates(head, pred)) loop.latches.push_back(pred);
+        }
+        if (loop.latches.empty()) continue;
+
+        // The loop is everything that reaches a latch without going through the head.
+        loop.blocks.push_back(head);
+        inLoop[head] = head;
+        std::vector<CFGBlockId> work;
+        for (CFGBlockId latch : loop.latches)
+        {
+            if (inLoop[latch] == head) continue;
+            inLoop[latch] = head;
+            loop.blocks.push_back(latch);
+            work.push_back(latch);
+        }
+        while (!work.empty())
+        {
+            CFGBlockId block = work.back();
+            work.pop_back();
+            for (CFGBlockId pred : cfg.blocks[block].predecessors)
+            {
+                if (inLoop[pred] == head || !IsReachable(pred)) continue;
+                inLoop[pred] = head;
+                loop.blocks.push_back(pred);
+                work.push_back(pred);
+            }
+        }
+        loops.push_back(std::move(loop));
+    }
+    return loops;
+}
+
+SSAForm::SSAForm(const CFG& cfg) : cfg(cfg), dominators(cfg), accessValues(cfg.accesses.size(), SSA_NONE), phis(cfg.blocks.size())
+{
+    size_t varCount = cfg.variables.size();
+    for (uint32_t var = 0; var < varCount; var++) values.push_back({ SSAValueKind::Entry, var, CFG::ENTRY });
+
+    // Find the blocks that assign each variable, and which variables are read in a block before being assigned in it. Only those can need a phi.
+    std::vector<std::vector<CFGBlockId>> defBlocks(varCount);
+    std::vector<bool> needsPhis(varCount, false);
+    std::vector<CFGBlockId> assignedIn(varCount, CFG_NONE);
+    for (CFGBlockId block : dominators.order)
+    {
+        auto& info = cfg.blocks[block];
+        for (uint32_t i = info.firstAccess; i < info.firstAccess + info.accessCount; i++)
+        {
+            auto& access = cfg.accesses[i];
+            if (access.kind == CFGAccessKind::Use)
+            {
+                if (assignedIn[access.var] != block) needsPhis[access.var] = true;
+            }
+            else if (assignedIn[access.var] != block)
+            {
+                assignedIn[access.var] = block;
+                defBlocks[access.var].push_back(block);
+            }
+        }
+    }
+
+    // Place phis at the iterated dominance frontier of the blocks assigning each variable, where the entry counts as assigning all of them.
+    std::vector<uint32_t> hasPhi(cfg.blocks.size(), UINT32_MAX);
+    std::vector<uint32_t> queued(cfg.blocks.size(), UINT32_MAX);
+    std::vector<CFGBlockId> work;
+    for (uint32_t var = 0; var < varCount; var++)
+    {
+        if (!needsPhis[var] || defBlocks[var].empty()) continue;
+        work = defBlocks[var];
+        work.push_back(CFG::ENTRY);
+        for (CFGBlockId block : work) queued[block] = var;
+        while (!work.empty())
+        {
+            CFGBlockId block = work.back();
+            work.pop_back();
+            for (CFGBlockId frontier : dominators.frontiers[block])
+            {
+                if (hasPhi[frontier] == var) continue;
+                hasPhi[frontier] = var;
+                SSAValue phi = { SSAValueKind::Phi, var, frontier };
+                phi.operands.assign(cfg.blocks[frontier].predecessors.size(), SSA_NONE);
+                phis[frontier].push_back((SSAValueId)values.size());
+                values.push_back(std::move(phi));
+                if (queued[frontier] == var) continue;
+                queued[frontier] = var;
+                work.push_back(frontier);
+            }
+        }
+    }
+
+    // Rename by walking the dominator tree with an explicit stack. Entering a block logs the values it replaces, and leaving it puts them back.
+    std::vector<SSAValueId> current(varCount);
+    for (uint32_t var = 0; var < varCount; var++) current[var] = var;
+    std::vector<std::pair<uint32_t, SSAValueId>> replaced;
+    struct Frame
+    {
+        CFGBlockId block;
+        size_t replacedSize;
+        bool entered;
+    };
+    std::vector<Frame> stack = { { CFG::ENTRY, 0, false } };
+    while (!stack.empty())
+    {
+        Frame& frame = stack.back();
+        if (frame.entered)
+        {
+            for (size_t i = replaced.size(); i-- > frame.replacedSize;) current[replaced[i].first] = replaced[i].second;
+            replaced.resize(frame.replacedSize);
+            stack.pop_back();
+            continue;
+        }
+        frame.entered = true;
+        frame.replacedSize = replaced.size();
+        CFGBlockId block = frame.block;
+
+        // Phis and defs give their variables new values, and uses read the values so far.
+        for (SSAValueId phi : phis[block])
+        {
+            uint32_t var = values[phi].var;
+            replaced.push_back({ var, current[var] });
+            current[var] = phi;
+        }
+        auto& info = cfg.blocks[block];
+        for (uint32_t i = info.firstAccess; i < info.firstAccess + info.accessCount; i++)
+        {
+            uint32_t var = cfg.accesses[i].var;
+            if (cfg.accesses[i].kind == CFGAccessKind::Use)
+            {
+                accessValues[i] = current[var];
+                values[current[var]].uses.push_back(i);
+            }
+            else
+            {
+                accessValues[i] = (SSAValueId)values.size();
+                values.push_back({ SSAValueKind::Def, var, block, i });
+                replaced.push_back({ var, current[var] });
+                current[var] = accessValues[i];
+            }
+        }
+
+        // Hand the values at the end of the block to the phis of its successors, on every edge from it.
+        for (CFGBlockId successor : info.successors)
+        {
+            auto& preds = cfg.blocks[successor].predecessors;
+            for (size_t j = 0; j < preds.size(); j++)
+            {
+                if (preds[j] != block) continue;
+                for (SSAValueId phi : phis[successor])
+                {
+                    if (values[phi].operands[j] != SSA_NONE) continue; // Already handed over for this edge.
+                    SSAValueId value = current[values[phi].var];
+                    values[phi].operands[j] = value;
+                    values[value].phiUses.push_back(phi);
+                }
+            }
+        }
+        for (CFGBlockId child : dominators.children[block]) stack.push_back({ child, 0, false });
+    }
+
+}
\ No newline at end of file
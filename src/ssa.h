@@ -0,0 +1,134 @@
+#pragma once
+
+#include "cfg.h"
+#include <cstdint>
+#include <vector>
+
+// A natural loop of a CFG: a head that dominates a set of blocks which all lead back to it.
+struct CFGLoop
+{
+
+    // Block every iteration starts in.
+    CFGBlockId head;
+
+    // Loop node the loop was lowered from, see CFGBlock::loop.
+    ASTStatement* node;
+
+    // Blocks that go back to the head.
+    std::vector<CFGBlockId> latches;
+
+    // Every block of the loop, the head first.
+    std::vector<CFGBlockId> blocks;
+
+};
+
+// Dominators of every block of a CFG, found with the algorithm of Cooper, Harvey, and Kennedy. A block dominates another if every path from the entry to it goes through the block.
+// Blocks that can't be reached from the entry are left out: they have no immediate dominator and nothing dominates them.
+class DominatorTree
+{
+
+    // Position of each block in a preorder and postorder walk of the tree, to check dominance in constant time.
+    std::vector<uint32_t> preorder;
+    std::vector<uint32_t> postorder;
+
+public:
+
+    // Reachable blocks in reverse postorder.
+    std::vector<CFGBlockId> order;
+
+    // Immediate dominator of each block. CFG_NONE for the entry and unreachable blocks.
+    std::vector<CFGBlockId> idom;
+
+    // Blocks each block is the immediate dominator of.
+    std::vector<std::vector<CFGBlockId>> children;
+
+    // Dominance frontier of each block: the blocks it does not strictly dominate but dominates a predecessor of. This is where the values it defines meet others.
+    std::vector<std::vector<CFGBlockId>> frontiers;
+
+    // Find the dominators of a CFG.
+    // cfg: CFG to find the dominators of.
+    explicit DominatorTree(const CFG& cfg);
+
+    // If a block can be reached from the entry.
+    // block: Block to check.
+    bool IsReachable(CFGBlockId block) const { return block == CFG::ENTRY || idom[block] != CFG_NONE; }
+
+    // If a block dominates another. Every reachable block dominates itself.
+    // a: Block that may dominate.
+    // b: Block that may be dominated.
+    bool Dominates(CFGBlockId a, CFGBlockId b) const;
+
+    // Find the natural loops, from the back edges to blocks that dominate where they come from. Back edges to the same head make a single loop.
+    // cfg: CFG the dominators were found for.
+    // Returns: The loops, with outer loops before the loops nested in them.
+    std::vector<CFGLoop> FindLoops(const CFG& cfg) const;
+
+};
+
+// Handle of a value of an SSA form, which is its index in the values array.
+typedef uint32_t SSAValueId;
+
+// A missing value, like for a use in an unreachable block.
+constexpr SSAValueId SSA_NONE = UINT32_MAX;
+
+// Where an SSA value comes from.
+enum class SSAValueKind : uint8_t
+{
+    Entry, // The value a variable has when the function starts: the argument for a parameter, and undefined for anything else.
+    Def, // An assignment.
+    Phi // The value a variable has when control meets from blocks with different values of it.
+};
+
+// A single value of a variable, which is assigned exactly once.
+struct SSAValue
+{
+
+    // Where the value comes from.
+    SSAValueKind kind;
+
+    // Number of the variable, see CFG::variables.
+    uint32_t var;
+
+    // Block the value is made in.
+    CFGBlockId block;
+
+    // The def access that makes the value, or UINT32_MAX if it is not a def.
+    uint32_t access = UINT32_MAX;
+
+    // For a phi, the value coming from each predecessor of the block, in the order of the predecessors. SSA_NONE from predecessors that can't be reached.
+    std::vector<SSAValueId> operands;
+
+    // Use accesses that read the value.
+    std::vector<uint32_t> uses;
+
+    // Phis that take the value as an operand.
+    std::vector<SSAValueId> phiUses;
+
+};
+
+// Static single assignment form of a CFG, where every use of a variable reads exactly one value. It is built over the CFG, so the accesses still point into the AST.
+// Phis are placed at the iterated dominance frontiers of the assignments, but only for variables read in a block before being assigned in it (semi-pruned SSA).
+class SSAForm
+{
+public:
+
+    // CFG the form is for.
+    const CFG& cfg;
+
+    // Dominators of the CFG.
+    DominatorTree dominators;
+
+    // Every value. The entry values come first, one for each variable in order.
+    std::vector<SSAValue> values;
+
+    // Value of each access of the CFG: the value read by a use and the value made by a def. SSA_NONE for accesses in unreachable blocks.
+    std::vector<SSAValueId> accessValues;
+
+    // Phis at the start of each block.
+    std::vector<std::vector<SSAValueId>> phis;
+
+    // Build the SSA form of a CFG.
+    // cfg: CFG to build the form of. It must outlive the form.
+    explicit SSAForm(const CFG& cfg);
+
+};
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "statement.h"
+
+#include "statements/block.h"
+#include "statements/for.h"
+#include "statements/if.h"
+#include "statements/return.h"
+#include "statements/while.h"
+#include "expressions/assignment.h"
+#include "expressions/binary.h"
+#include "expressions/bool2Int.h"
+#include "expressions/call.h"
+#include "expressions/float2Int.h"
+#include "expressions/int2Bool.h"
+#include "expressions/int2Float.h"
+#include "expressions/negative.h"
+
+// Moves the children of a node onto a list, so the node can be freed without freeing them along with it.
+class ASTChildTaker : public ASTMutator
+{
+public:
+
+    // Nodes waiting to be freed.
+    std::vector<std::unique_ptr<ASTStatement>> work;
+
+    // Take a child if there is one.
+    // child: Child to take.
+    template <typename T>
+    void Take(std::unique_ptr<T>& child)
+    {
+        if (child) work.push_back(std::move(child));
+    }
+
+    void Visit(ASTStatementBlock& node) override
+    {
+        for (auto& statement : node.statements) Take(statement);
+    }
+
+    void Visit(ASTStatementIf& node) override
+    {
+        Take(node.condition);
+        Take(node.thenStatement);
+        Take(node.elseStatement);
+    }
+
+    void Visit(ASTStatementWhile& node) override
+    {
+        Take(node.condition);
+        Take(node.thenStatement);
+    }
+
+    void Visit(ASTStatementFor& node) override
+    {
+        Take(node.init);
+        Take(node.condition);
+        Take(node.increment);
+        Take(node.body);
+    }
+
+    void Visit(ASTStatementReturn& node) override { Take(node.returnExpression); }
+
+    void Visit(ASTExpressionCall& node) override
+    {
+        Take(node.callee);
+        for (auto& argument : node.arguments) Take(argument);
+    }
+
+    void Visit(ASTExpressionAssignment& node) override
+    {
+        Take(node.left);
+        Take(node.right);
+    }
+
+    void Visit(ASTExpressionBinary& node) override
+    {
+        Take(node.a1);
+        Take(node.a2);
+    }
+
+    void Visit(ASTExpressionNegation& node) override { Take(node.operand); }
+    void Visit(ASTExpressionInt2Float& node) override { Take(node.operand); }
+    void Visit(ASTExpressionFloat2Int& node) override { Take(node.operand); }
+    void Visit(ASTExpressionInt2Bool& node) override { Take(node.operand); }
+    void Visit(ASTExpressionBool2Int& node) override { Take(node.operand); }
+
+};
+
+void ASTStatement::Destroy(std::unique_ptr<ASTStatement> root)
+{
+    ASTChildTaker taker;
+    taker.Take(root);
+    while (!taker.work.empty())
+    {
+        std::unique_ptr<ASTStatement> node = std::move(taker.work.back());
+        taker.work.pop_back();
+        node->Accept(taker); // Freeing the node at the end of the iteration is now shallow.
+    }
+}
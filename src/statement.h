@@ -1,34 +1,100 @@
 #pragma once
 
+#include "arena.h"
 #include "varType.h"
+#include "visitor.h"
+#include <cstdint>
+#include <memory>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Value.h>
 
 // Forward declarations.
 class ASTFunction;
 
+// Every kind of node. Passes tell nodes apart by comparing this instead of trying dynamic_casts. Expressions come last.
+enum class ASTNodeKind : uint8_t
+{
+    Block,
+    If,
+    While,
+    For,
+    Return,
+    Int,
+    Float,
+    Bool,
+    String,
+    Variable,
+    Call,
+    Assignment,
+    Addition,
+    Subtraction,
+    Multiplication,
+    Division,
+    Comparison,
+    And,
+    Or,
+    Negation,
+    Int2Float,
+    Float2Int,
+    Int2Bool,
+    Bool2Int
+};
+
 // A statement (like a single expression, collection of expressions, loop, if statement, etc).
-class ASTStatement
+class ASTStatement : public ArenaAllocated
 {
 public:
 
-    // Get the return type of the statement.
+    // What kind of node this is. Each node class has its kind as KIND.
+    const ASTNodeKind kind;
+
+    // Create a new statement.
+    // kind: What kind of node this is.
+    explicit ASTStatement(ASTNodeKind kind) : kind(kind) {}
+
+    // If this node is an expression.
+    bool IsExpression() const { return kind >= ASTNodeKind::Int; }
+
+    // Hand this node to the visitor's function for its class.
+    // visitor: Visitor to call.
+    virtual void Accept(ASTVisitor& visitor) const = 0;
+
+    // Hand this node to the mutator's function for its class.
+    // mutator: Mutator to call.
+    virtual void Accept(ASTMutator& mutator) = 0;
+
+    // Type of a return the statement definitely ends in, found by type checking. Null if the statement may finish without returning.
+    const VarType* definiteReturnType = nullptr;
+
+    // Type check the statement and everything in it, adding implicit casts where needed. Working from the bottom up, this also finds the definite return type.
+    // This must be done before getting return types or compiling.
     // func: Current AST function.
+    virtual void TypeCheck(ASTFunction& func) = 0;
+
+    // Get the return type of the statement. Must be type checked first, this only reads what it found.
     // Returns: Either a return type if a return statement is definitive, or nullptr if there is none.
-    virtual std::unique_ptr<VarType> StatementReturnType(ASTFunction& func) = 0;
+    const VarType* StatementReturnType() const { return definiteReturnType; }
 
     // Compile the code statement.
     // mod: LLVM module that contains the statement.
     // builder: Instruction builder tied to the current LLVM function.
     // func: AST function to compile.
     // Returns: The return value from the statement. IMPORTANT NOTE: This is a *return* value, not just a value from a single expression! This means unless the value is an explicit return value, you should return nullptr!
-    virtual void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) = 0;
+    virtual void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) const = 0;
 
-    // Recursively build a string representation of this statement.
-    // Prefix: the string to be inserted on the left side of the tree.
-    // Returns: a string representation of this statement, in the form of a tree data structure.
-    virtual std::string ToString(const std::string& prefix) = 0;
+    // Free a tree with a stack of its own, so even a deeply nested one can be freed on a small stack. Letting the nodes free their children instead recurses once for each level of nesting.
+    // root: Tree to free. May be null.
+    static void Destroy(std::unique_ptr<ASTStatement> root);
 
     // Must make the destructor virtual to make the compiler happy.
     virtual ~ASTStatement() = default;
-};
\ No newline at end of file
+};
+
+// Get a node as a node class if it is of that class's kind. Unlike a dynamic_cast, this is a single compare.
+// node: Node to cast. May be null.
+// Returns: The node as the class, or null if it is of another kind.
+template <typename T>
+T* ASTCast(ASTStatement* node)
+{
+    return node && node->kind == T::KIND ? static_cast<T*>(node) : nullptr;
+}
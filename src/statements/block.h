@@ -7,12 +7,19 @@ class ASTStatementBlock : public ASTStatement
 {
 public:
 
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Block;
+
     // List of statements. Modify these as needed :}
     std::vector<std::unique_ptr<ASTStatement>> statements;
 
+    // Create a new empty block.
+    ASTStatementBlock() : ASTStatement(KIND) {}
+
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> StatementReturnType(ASTFunction& func) override;
-    void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    void TypeCheck(ASTFunction& func) override;
+    void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 
 };
\ No newline at end of file
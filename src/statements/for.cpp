@@ -2,20 +2,20 @@
 
 #include "../function.h"
 
-std::unique_ptr<VarType> ASTStatementFor::StatementReturnType(ASTFunction& func)
+void ASTStatementFor::TypeCheck(ASTFunction& func)
 {
 
-    if(init && init->StatementReturnType(func)) {
-        return init->StatementReturnType(func);
-    }
-    else {
-        // It is completely possible for a for loop's condition to never be true, so even if does return something it's not confirmed.
-        return nullptr;
-    }
+    if (init) init->TypeCheck(func);
+    if (condition) condition->TypeCheck(func);
+    if (increment) increment->TypeCheck(func);
+    if (body) body->TypeCheck(func);
+
+    // Only the init statement always runs. It is completely possible for a for loop's condition to never be true, so even if the body does return something it's not confirmed.
+    definiteReturnType = init ? init->StatementReturnType() : nullptr;
 
 }
 
-void ASTStatementFor::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func)
+void ASTStatementFor::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) const
 {
 
     /*
@@ -65,7 +65,7 @@ void ASTStatementFor::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, AST
     if(init) {
         init->Compile(mod, builder, func);
         // If init statement does not return, continue creating loop.
-        if (!init->StatementReturnType(func)) builder.CreateBr(forLoop);
+        if (!init->StatementReturnType()) builder.CreateBr(forLoop);
     }
     // Otherwise, skip init statement.
     else {
@@ -84,11 +84,11 @@ void ASTStatementFor::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, AST
         builder.CreateBr(forLoopBody);
     }
 
-    // Compile the body. Note that we need to not create a jump if there is a return.
+    // Compile the body, which dead code elimination may have removed entirely. Note that we need to not create a jump if there is a return.
     builder.SetInsertPoint(forLoopBody);
-    body->Compile(mod, builder, func);
+    if (body) body->Compile(mod, builder, func);
     // If body does not return, continue creating loop.
-    if (!body->StatementReturnType(func)) builder.CreateBr(forLoopContinue);
+    if (!body || !body->StatementReturnType()) builder.CreateBr(forLoopContinue);
 
     // Compile inc statement and jump to the for loop.
     builder.SetInsertPoint(forLoopContinue);
@@ -96,7 +96,7 @@ void ASTStatementFor::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, AST
     if(increment) {
         increment->Compile(mod, builder, func);
         // If increment statement does not return, continue creating loop.
-        if (!increment->StatementReturnType(func)) builder.CreateBr(forLoop);
+        if (!increment->StatementReturnType()) builder.CreateBr(forLoop);
     }
     // Otherwise, skip increment statement.
     else {
@@ -106,14 +106,4 @@ void ASTStatementFor::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, AST
     // Continue from the end of the created for loop.
     builder.SetInsertPoint(forLoopEnd);
 
-}
-
-std::string ASTStatementFor::ToString(const std::string& prefix)
-{
-    std::string output = "for\n";
-    output += prefix + "├──" + body->ToString(prefix + "│  ");
-    output += prefix + "├──" + init->ToString(prefix + "│  ");
-    output += prefix + "├──" + condition->ToString(prefix + "│  ");
-    output += prefix + "└──" + increment->ToString(prefix + "   ");
-    return output;
 }
\ No newline at end of file
@@ -2,12 +2,17 @@
 
 #include "../expression.h"
 #include "../statement.h"
+#include <cstdint>
 
 // For a for loop statement.
 class ASTStatementFor : public ASTStatement
 {
 
 public:
+
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::For;
+
     // Loop body to execute.
     std::unique_ptr<ASTStatement> body;
     
@@ -19,13 +24,16 @@ public:
 
     // Increment statement to execute.
     std::unique_ptr<ASTStatement> increment;
+
+    // Number of times the body runs, if range analysis found it, or -1 if it is not known. See RangeAnalyzer. Dead code elimination sets it back to -1 when it removes code from the loop, so passes after that should not expect it.
+    int64_t tripCount = -1;
     
     // Create a new for statement.
     // body: Statement to execute while the condition is true.
     // init: Statement to execute on loop start.
     // condition: Condition to check.
     // increment: Statement to execute after each iteration.
-    ASTStatementFor(std::unique_ptr<ASTStatement> body, std::unique_ptr<ASTStatement> init, std::unique_ptr<ASTExpression> condition, std::unique_ptr<ASTStatement> increment) : body(std::move(body)), init(std::move(init)), condition(std::move(condition)), increment(std::move(increment)) {}
+    ASTStatementFor(std::unique_ptr<ASTStatement> body, std::unique_ptr<ASTStatement> init, std::unique_ptr<ASTExpression> condition, std::unique_ptr<ASTStatement> increment) : ASTStatement(KIND), body(std::move(body)), init(std::move(init)), condition(std::move(condition)), increment(std::move(increment)) {}
 
     // Create a new for statement.
     // body: Statement to execute while the condition is true.
@@ -38,8 +46,9 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    virtual std::unique_ptr<VarType> StatementReturnType(ASTFunction& func) override;
-    virtual void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    virtual std::string ToString(const std::string& prefix) override;
+    virtual void TypeCheck(ASTFunction& func) override;
+    virtual void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    virtual void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    virtual void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 
 };
\ No newline at end of file
@@ -2,30 +2,37 @@
 
 #include "../function.h"
 
-std::unique_ptr<VarType> ASTStatementIf::StatementReturnType(ASTFunction& func)
+void ASTStatementIf::TypeCheck(ASTFunction& func)
 {
+
+    // Check the condition. TODO: TO BOOLEAN CAST CONVERSION?
+    condition->TypeCheck(func);
+    if (!condition->ReturnType()->Equals(&VarTypeSimple::BoolType))
+        throw std::runtime_error("ERROR: Expected condition that returns a boolean value but got another type instead!");
+    if (thenStatement) thenStatement->TypeCheck(func);
+    if (elseStatement) elseStatement->TypeCheck(func);
+
     // This is a bit of a strange case. We don't know for certain what the return type is unless both if and else return something.
     // In the case they both return something, have to make sure the return types match.
-
-    // If we don't have an else statement, then we can't guarantee a return.
-    if (!elseStatement) return nullptr;
+    // If we don't have both branches, then we can't guarantee a return.
+    definiteReturnType = nullptr;
+    if (!thenStatement || !elseStatement) return;
 
     // Get return types. Return if either do not return anything.
-    auto thenRet = thenStatement->StatementReturnType(func);
-    auto elseRet = elseStatement->StatementReturnType(func);
-    if (!thenRet || !elseRet) return nullptr;
+    auto thenRet = thenStatement->StatementReturnType();
+    auto elseRet = elseStatement->StatementReturnType();
+    if (!thenRet || !elseRet) return;
 
     // Check for matching return types.
-    if (thenRet->Equals(elseRet.get())) return std::move(thenRet); // Return if equal.
+    if (thenRet->Equals(elseRet)) definiteReturnType = thenRet;
     else throw std::runtime_error("ERROR: If/Else statements both return a value but their return types don't match!");
+
 }
 
-void ASTStatementIf::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func)
+void ASTStatementIf::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) const
 {
-    // Compile the condition. TODO: TO BOOLEAN CAST CONVERSION?
-    if (!condition->ReturnType(func)->Equals(&VarTypeSimple::BoolType))
-        throw std::runtime_error("ERROR: Expected condition that returns a boolean value but got another type instead!");
-    llvm::Value* cond = condition->Compile(builder, func);
+    // Compile the condition. A variable compiles to its address, so its value has to be loaded.
+    llvm::Value* cond = condition->CompileRValue(builder, func);
 
     // Create blocks.
     auto* funcVal = (llvm::Function*)func.GetVariableValue(func.name);
@@ -37,27 +44,19 @@ void ASTStatementIf::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTF
     // Make jumps to blocks.
     builder.CreateCondBr(cond, thenBlock, elseBlock ? elseBlock : contBlock); // Use else as false if exists, otherwise go to continuation.
 
-    // Compile the then block and then jump to continuation block.
+    // Compile the then block and then jump to continuation block. Dead code elimination may have removed it entirely.
     builder.SetInsertPoint(thenBlock);
-    thenStatement->Compile(mod, builder, func);
-    if (!thenStatement->StatementReturnType(func)) builder.CreateBr(contBlock); // Only create branch if no return encountered.
+    if (thenStatement) thenStatement->Compile(mod, builder, func);
+    if (!thenStatement || !thenStatement->StatementReturnType()) builder.CreateBr(contBlock); // Only create branch if no return encountered.
 
     // Compile the else block if applicable.
     if (elseBlock)
     {
         builder.SetInsertPoint(elseBlock);
         elseStatement->Compile(mod, builder, func);
-        if (!elseStatement->StatementReturnType(func)) builder.CreateBr(contBlock); // Only create branch if no return encountered.
+        if (!elseStatement->StatementReturnType()) builder.CreateBr(contBlock); // Only create branch if no return encountered.
     }
 
     // Resume compilation at continuation block.
     builder.SetInsertPoint(contBlock);
-}
-
-std::string ASTStatementIf::ToString(const std::string& prefix)
-{
-    std::string output = "if\n" + prefix + "├──" + condition->ToString(prefix + "│  ");
-    output += prefix + (elseStatement ? "├──" : "└──") + thenStatement->ToString(prefix + (elseStatement ? "│  " : "   "));
-    if (elseStatement) output += prefix + "└──" + elseStatement->ToString(prefix + "   ");
-    return output;
 }
\ No newline at end of file
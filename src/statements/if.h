@@ -9,6 +9,9 @@ class ASTStatementIf : public ASTStatement
 
 public:
 
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::If;
+
     // Condition to check.
     std::unique_ptr<ASTExpression> condition;
 
@@ -22,7 +25,7 @@ public:
     // condition: Condition to check.
     // thenStatement: Statement to execute if the condition is true.
     // elseStatement: Statement to execute if the condition is false.
-    ASTStatementIf(std::unique_ptr<ASTExpression> condition, std::unique_ptr<ASTStatement> thenStatement, std::unique_ptr<ASTStatement> elseStatement) : condition(std::move(condition)), thenStatement(std::move(thenStatement)), elseStatement(std::move(elseStatement)) {}
+    ASTStatementIf(std::unique_ptr<ASTExpression> condition, std::unique_ptr<ASTStatement> thenStatement, std::unique_ptr<ASTStatement> elseStatement) : ASTStatement(KIND), condition(std::move(condition)), thenStatement(std::move(thenStatement)), elseStatement(std::move(elseStatement)) {}
 
     // Create a new if statement.
     // condition: Condition to check.
@@ -34,8 +37,9 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    virtual std::unique_ptr<VarType> StatementReturnType(ASTFunction& func) override;
-    virtual void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    virtual std::string ToString(const std::string& prefix) override;
+    virtual void TypeCheck(ASTFunction& func) override;
+    virtual void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    virtual void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    virtual void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 
 };
\ No newline at end of file
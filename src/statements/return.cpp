@@ -2,30 +2,27 @@
 
 #include "../types/simple.h"
 
-std::unique_ptr<VarType> ASTStatementReturn::StatementReturnType(ASTFunction& func)
+void ASTStatementReturn::TypeCheck(ASTFunction& func)
 {
-    // If the contained statement returns something, return it.
-    // Otherwise, we return void.
-    return returnExpression ? returnExpression->ReturnType(func) : VarTypeSimple::VoidType.Copy();
+
+    // If there is no contained expression, we return void.
+    definiteReturnType = &VarTypeSimple::VoidType;
+    if (!returnExpression) return;
+
+    // Otherwise, we return what it does.
+    returnExpression->TypeCheck(func);
+    if (returnExpression->ReturnType()->Equals(&VarTypeSimple::VoidType))
+        throw std::runtime_error("ERROR: Illegal return of void type");
+    definiteReturnType = returnExpression->ReturnType();
+
 }
 
-void ASTStatementReturn::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func)
+void ASTStatementReturn::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) const
 {
-    // If there is a contained expression, compile it.
+    // If there is a contained expression, compile it once for its value, so its calls and assignments only run once.
     if (returnExpression)
     {
-        returnExpression->Compile(mod, builder, func);
-        if (returnExpression->ReturnType(func)->Equals(&VarTypeSimple::VoidType))
-            throw std::runtime_error("ERROR: Illegal return of void type");
         builder.CreateRet(returnExpression->CompileRValue(builder, func));
     } else // If no contained expression exists, make a void return.
         builder.CreateRetVoid();
-}
-
-std::string ASTStatementReturn::ToString(const std::string& prefix)
-{
-    std::string output = "return\n";
-    if (returnExpression)
-        output += prefix + "└──" + returnExpression->ToString(prefix + "   ");
-    return output;
 }
\ No newline at end of file
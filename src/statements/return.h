@@ -7,11 +7,18 @@ class ASTStatementReturn : public ASTStatement
 {
 public:
 
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::Return;
+
     // expression to return
     std::unique_ptr<ASTExpression> returnExpression;
 
+    // Create a new return statement.
+    ASTStatementReturn() : ASTStatement(KIND) {}
+
     // Virtual functions. See base class for details.
-    std::unique_ptr<VarType> StatementReturnType(ASTFunction& func) override;
-    void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    std::string ToString(const std::string& prefix) override;
+    void TypeCheck(ASTFunction& func) override;
+    void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 };
\ No newline at end of file
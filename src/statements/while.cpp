@@ -2,15 +2,14 @@
 
 #include "../function.h"
 
-std::unique_ptr<VarType> ASTStatementWhile::StatementReturnType(ASTFunction& func)
+void ASTStatementWhile::TypeCheck(ASTFunction& func)
 {
-
-    // It is completely possible for a while loop's condition to never be true, so even if does return something it's not confirmed.
-    return nullptr;
-
+    condition->TypeCheck(func);
+    if (thenStatement) thenStatement->TypeCheck(func);
+    definiteReturnType = nullptr; // It is completely possible for a while loop's condition to never be true, so even if does return something it's not confirmed.
 }
 
-void ASTStatementWhile::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func)
+void ASTStatementWhile::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) const
 {
 
     /*
@@ -50,20 +49,12 @@ void ASTStatementWhile::Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, A
     auto conditionVal = condition->CompileRValue(builder, func);
     builder.CreateCondBr(conditionVal, whileLoopBody, whileLoopEnd);
 
-    // Compile the body. Note that we need to not create a jump if there is a return.
+    // Compile the body, which dead code elimination may have removed entirely. Note that we need to not create a jump if there is a return.
     builder.SetInsertPoint(whileLoopBody);
-    thenStatement->Compile(mod, builder, func);
-    if (!thenStatement->StatementReturnType(func)) builder.CreateBr(whileLoop);
+    if (thenStatement) thenStatement->Compile(mod, builder, func);
+    if (!thenStatement || !thenStatement->StatementReturnType()) builder.CreateBr(whileLoop);
 
     // Continue from the end of the created while loop.
     builder.SetInsertPoint(whileLoopEnd);
 
-}
-
-std::string ASTStatementWhile::ToString(const std::string& prefix)
-{
-    std::string output = "while\n";
-    output += prefix + "├──" + condition->ToString(prefix + "│  ");
-    output += prefix + "└──" + thenStatement->ToString(prefix + "   ");
-    return output;
 }
\ No newline at end of file
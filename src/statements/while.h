@@ -2,6 +2,7 @@
 
 #include "../expression.h"
 #include "../statement.h"
+#include <cstdint>
 
 // For a while loop statement.
 class ASTStatementWhile : public ASTStatement
@@ -9,16 +10,22 @@ class ASTStatementWhile : public ASTStatement
 
 public:
 
+    // Kind of node, see ASTNodeKind.
+    static constexpr ASTNodeKind KIND = ASTNodeKind::While;
+
     // Condition to check.
     std::unique_ptr<ASTExpression> condition;
 
     // Then statement to execute.
     std::unique_ptr<ASTStatement> thenStatement;
+
+    // Number of times the body runs, if range analysis found it, or -1 if it is not known. See RangeAnalyzer. Dead code elimination sets it back to -1 when it removes code from the loop, so passes after that should not expect it.
+    int64_t tripCount = -1;
     
     // Create a new while statement.
     // condition: Condition to check.
     // thenStatement: Statement to execute while the condition is true.
-    ASTStatementWhile(std::unique_ptr<ASTExpression> condition, std::unique_ptr<ASTStatement> thenStatement) : condition(std::move(condition)), thenStatement(std::move(thenStatement)) {}
+    ASTStatementWhile(std::unique_ptr<ASTExpression> condition, std::unique_ptr<ASTStatement> thenStatement) : ASTStatement(KIND), condition(std::move(condition)), thenStatement(std::move(thenStatement)) {}
 
     // Create a new while statement.
     // condition: Condition to check.
@@ -29,8 +36,9 @@ public:
     }
 
     // Virtual functions. See base class for details.
-    virtual std::unique_ptr<VarType> StatementReturnType(ASTFunction& func) override;
-    virtual void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) override;
-    virtual std::string ToString(const std::string& prefix) override;
+    virtual void TypeCheck(ASTFunction& func) override;
+    virtual void Compile(llvm::Module& mod, llvm::IRBuilder<>& builder, ASTFunction& func) const override;
+    virtual void Accept(ASTVisitor& visitor) const override { visitor.Visit(*this); }
+    virtual void Accept(ASTMutator& mutator) override { mutator.Visit(*this); }
 
 };
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "symbol.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+// Global table of every interned name.
+struct SymbolTable
+{
+
+    // Names indexed by ID. A deque never moves its elements, so the map below can hold views into it.
+    std::deque<std::string> names;
+
+    // Map names to their IDs.
+    std::unordered_map<std::string_view, uint32_t> ids;
+
+    // Symbols can be created from multiple threads at once.
+    std::mutex mutex;
+
+    // Start with the empty name as ID 0.
+    SymbolTable()
+    {
+        names.emplace_back();
+        ids.emplace(names.back(), 0);
+    }
+
+};
+
+// The table is created on first use so symbols can be made during static initialization.
+static SymbolTable& GetSymbolTable()
+{
+    static SymbolTable table;
+    return table;
+}
+
+uint32_t Symbol::Intern(std::string_view name)
+{
+    SymbolTable& table = GetSymbolTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto found = table.ids.find(name);
+    if (found != table.ids.end()) return found->second; // Already interned.
+    uint32_t newId = (uint32_t)table.names.size();
+    table.names.emplace_back(name);
+    table.ids.emplace(table.names.back(), newId);
+    return newId;
+}
+
+const std::string& Symbol::Name() const
+{
+    SymbolTable& table = GetSymbolTable();
+    std::lock_guard<std::mutex> lock(table.mutex); // The deque's index may be resized by another thread interning.
+    return table.names[id];
+}
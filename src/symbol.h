@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// An interned name, used for variables and functions.
+// Every distinct name is stored once in a global table and given a small integer ID, so comparing and hashing symbols is just comparing integers.
+class Symbol
+{
+
+    // Index of the name in the global symbol table. 0 is the empty name.
+    uint32_t id = 0;
+
+    // Find or add a name in the global symbol table. This is thread safe.
+    // name: Name to intern.
+    // Returns: ID of the name.
+    static uint32_t Intern(std::string_view name);
+
+public:
+
+    // Create a symbol with an empty name.
+    Symbol() = default;
+
+    // Intern a name. Symbols of equal names are always equal.
+    // name: Name of the symbol.
+    Symbol(std::string_view name) : id(Intern(name)) {}
+    Symbol(const std::string& name) : id(Intern(name)) {}
+    Symbol(const char* name) : id(Intern(name)) {}
+
+    // Get the name of the symbol. The reference stays valid for the lifetime of the program.
+    const std::string& Name() const;
+
+    // Get the unique ID of the symbol.
+    uint32_t Id() const { return id; }
+
+    // Symbols compare by ID only, no string comparisons are needed.
+    bool operator==(const Symbol& other) const { return id == other.id; }
+    bool operator!=(const Symbol& other) const { return id != other.id; }
+    bool operator<(const Symbol& other) const { return id < other.id; }
+
+};
+
+// Allows symbols to be used as keys in unordered containers.
+template <>
+struct std::hash<Symbol>
+{
+    size_t operator()(const Symbol& symbol) const { return symbol.Id(); }
+};
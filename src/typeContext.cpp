@@ -0,0 +1,19 @@
+#include "typeContext.h"
+
+#include <functional>
+
+size_t VarTypeFunctionKeyHash::operator()(const VarTypeFunctionKey& key) const
+{
+    size_t hash = std::hash<const VarType*>()(key.returnType) ^ (size_t)key.varArgs;
+    for (auto param : key.parameterTypes) hash = hash * 31 + std::hash<const VarType*>()(param);
+    return hash;
+}
+
+const VarTypeFunction* TypeContext::GetFunctionType(const VarType* returnType, std::vector<const VarType*> parameterTypes, bool varArgs)
+{
+    VarTypeFunctionKey key { returnType, std::move(parameterTypes), varArgs };
+    auto found = functionTypes.find(key);
+    if (found != functionTypes.end()) return found->second.get(); // Already made.
+    auto type = std::make_unique<VarTypeFunction>(key.returnType, key.parameterTypes, varArgs);
+    return functionTypes.emplace(std::move(key), std::move(type)).first->second.get();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "types/function.h"
+#include "types/simple.h"
+#include "varType.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Everything that makes a function type distinct, to look up the one instance of it.
+struct VarTypeFunctionKey
+{
+
+    // Return type.
+    const VarType* returnType;
+
+    // Parameter types.
+    std::vector<const VarType*> parameterTypes;
+
+    // If the function type is variadic.
+    bool varArgs;
+
+    // Types are interned, so comparing the pointers is enough.
+    bool operator==(const VarTypeFunctionKey& other) const
+    {
+        return returnType == other.returnType && parameterTypes == other.parameterTypes && varArgs == other.varArgs;
+    }
+
+};
+
+// Hash of a function type key, mixed from the pointers of the types in it.
+struct VarTypeFunctionKeyHash
+{
+    size_t operator()(const VarTypeFunctionKey& key) const;
+};
+
+// Hands out types so each distinct type exists exactly once. Types can then be compared by pointer and never need to be copied.
+// Simple types are the shared constants of VarTypeSimple. Function types belong to the context, so it must outlive everything that points to them.
+// Like the AST owning it, a context is not thread safe.
+class TypeContext
+{
+
+    // Function types made so far.
+    std::unordered_map<VarTypeFunctionKey, std::unique_ptr<VarTypeFunction>, VarTypeFunctionKeyHash> functionTypes;
+
+public:
+
+    // Get the one instance of a function type, creating it if this is the first time it is asked for.
+    // returnType: What type the function returns.
+    // parameterTypes: Types of each parameter.
+    // varArgs: If the function type is variadic.
+    // Returns: The function type.
+    const VarTypeFunction* GetFunctionType(const VarType* returnType, std::vector<const VarType*> parameterTypes, bool varArgs = false);
+
+};
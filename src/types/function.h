@@ -1,14 +1,16 @@
 #pragma once
 
 #include "../varType.h"
+#include <vector>
 
 // Type that represents a function.
 class VarTypeFunction : public VarType
 {
 private:
 
-    // Prefetched LLVM type.
-    llvm::Type* funcType = nullptr;
+    // Prefetched LLVM type, and the context it was made in. Fetching it does not change the type, so it can be filled in on const types.
+    mutable llvm::Type* funcType = nullptr;
+    mutable llvm::LLVMContext* funcTypeContext = nullptr;
 
 public:
 
@@ -16,19 +18,18 @@ public:
     bool varArgs;
 
     // Return type.
-    std::unique_ptr<VarType> returnType;
+    const VarType* returnType;
 
     // Parameter types.
-    std::vector<std::unique_ptr<VarType>> parameterTypes;
+    std::vector<const VarType*> parameterTypes;
 
-    // Create a function type.
+    // Create a function type. Get them from a TypeContext instead, so each function type exists once.
     // returnType: What type the function returns.
     // parameterTypes: Types of each parameter.
-    VarTypeFunction(std::unique_ptr<VarType> returnType, std::vector<std::unique_ptr<VarType>> parameterTypes, bool varArgs = false) : returnType(std::move(returnType)), parameterTypes(std::move(parameterTypes)), varArgs(varArgs) {}
+    // varArgs: If the function type is variadic.
+    VarTypeFunction(const VarType* returnType, std::vector<const VarType*> parameterTypes, bool varArgs = false) : returnType(returnType), parameterTypes(std::move(parameterTypes)), varArgs(varArgs) {}
 
     // Virtual functions. See base class for details.
-    virtual std::unique_ptr<VarType> Copy() override;
-    virtual llvm::Type* GetLLVMType(llvm::LLVMContext& ctx) override;
-    virtual bool Equals(VarType* other) override;
+    virtual llvm::Type* GetLLVMType(llvm::LLVMContext& ctx) const override;
 
 };
\ No newline at end of file
@@ -6,12 +6,7 @@ VarTypeSimple VarTypeSimple::IntType = VarTypeSimple(VarTypeSimpleEnumeration::I
 VarTypeSimple VarTypeSimple::FloatType = VarTypeSimple(VarTypeSimpleEnumeration::Float);
 VarTypeSimple VarTypeSimple::StringType = VarTypeSimple(VarTypeSimpleEnumeration::String);
 
-std::unique_ptr<VarType> VarTypeSimple::Copy()
-{
-    return std::make_unique<VarTypeSimple>(type);
-}
-
-llvm::Type* VarTypeSimple::GetLLVMType(llvm::LLVMContext& ctx)
+llvm::Type* VarTypeSimple::GetLLVMType(llvm::LLVMContext& ctx) const
 {
     switch (type)
     {
@@ -22,14 +17,4 @@ llvm::Type* VarTypeSimple::GetLLVMType(llvm::LLVMContext& ctx)
         case VarTypeSimpleEnumeration::String: return (llvm::Type*)llvm::Type::getInt8PtrTy(ctx);
     }
     return nullptr;
-}
-
-bool VarTypeSimple::Equals(VarType* other)
-{
-    VarTypeSimple* casted = dynamic_cast<VarTypeSimple*>(other);
-    if (casted) // This is null if the cast fails (meaning it's not really a simple type).
-    {
-        return casted->type == type;
-    }
-    else return false;
 }
\ No newline at end of file
@@ -19,6 +19,10 @@ class VarTypeSimple : public VarType
     // Actual type stored.
     VarTypeSimpleEnumeration type;
 
+    // Create a new simple type from the enumeration. Only the constants below are made, so each simple type exists once.
+    // type: What type of simple variable type to instantiate.
+    VarTypeSimple(VarTypeSimpleEnumeration type) : type(type) {}
+
 public:
 
     // Constant types to help.
@@ -28,13 +32,7 @@ public:
     static VarTypeSimple FloatType;
     static VarTypeSimple StringType;
 
-    // Create a new simple type from the enumeration. You probably don't need to use this!
-    // type: What type of simple variable type to instantiate.
-    VarTypeSimple(VarTypeSimpleEnumeration type) : type(type) {}
-
     // Virtual functions. See base class for details.
-    virtual std::unique_ptr<VarType> Copy() override;
-    virtual llvm::Type* GetLLVMType(llvm::LLVMContext& ctx) override;
-    virtual bool Equals(VarType* other) override;
+    virtual llvm::Type* GetLLVMType(llvm::LLVMContext& ctx) const override;
 
 };
\ No newline at end of file
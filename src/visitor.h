@@ -0,0 +1,85 @@
+#pragma once
+
+// Forward declarations of every node class.
+class ASTStatementBlock;
+class ASTStatementIf;
+class ASTStatementWhile;
+class ASTStatementFor;
+class ASTStatementReturn;
+class ASTExpressionInt;
+class ASTExpressionFloat;
+class ASTExpressionBool;
+class ASTExpressionString;
+class ASTExpressionVariable;
+class ASTExpressionCall;
+class ASTExpressionAssignment;
+class ASTExpressionBinary;
+class ASTExpressionNegation;
+class ASTExpressionInt2Float;
+class ASTExpressionFloat2Int;
+class ASTExpressionInt2Bool;
+class ASTExpressionBool2Int;
+
+// Walks over nodes without changing them, like for printing.
+// A node hands itself to the function for its class in a single virtual call, so there is no need to find out what it is by casting.
+// Nodes a visitor doesn't care about are ignored by default. Visiting the children of a node is up to the visitor.
+class ASTVisitor
+{
+public:
+
+    // Visit a node of each class.
+    // node: Node being visited.
+    virtual void Visit(const ASTStatementBlock& node) {}
+    virtual void Visit(const ASTStatementIf& node) {}
+    virtual void Visit(const ASTStatementWhile& node) {}
+    virtual void Visit(const ASTStatementFor& node) {}
+    virtual void Visit(const ASTStatementReturn& node) {}
+    virtual void Visit(const ASTExpressionInt& node) {}
+    virtual void Visit(const ASTExpressionFloat& node) {}
+    virtual void Visit(const ASTExpressionBool& node) {}
+    virtual void Visit(const ASTExpressionString& node) {}
+    virtual void Visit(const ASTExpressionVariable& node) {}
+    virtual void Visit(const ASTExpressionCall& node) {}
+    virtual void Visit(const ASTExpressionAssignment& node) {}
+    virtual void Visit(const ASTExpressionBinary& node) {} // Arithmetic, comparisons, and logic all come here, tell them apart by kind.
+    virtual void Visit(const ASTExpressionNegation& node) {}
+    virtual void Visit(const ASTExpressionInt2Float& node) {}
+    virtual void Visit(const ASTExpressionFloat2Int& node) {}
+    virtual void Visit(const ASTExpressionInt2Bool& node) {}
+    virtual void Visit(const ASTExpressionBool2Int& node) {}
+
+    // Must make the destructor virtual to make the compiler happy.
+    virtual ~ASTVisitor() = default;
+
+};
+
+// Same as the visitor, but for passes that rewrite the tree. Nodes are handed over mutable, so children can be replaced or removed.
+class ASTMutator
+{
+public:
+
+    // Visit a node of each class.
+    // node: Node being visited.
+    virtual void Visit(ASTStatementBlock& node) {}
+    virtual void Visit(ASTStatementIf& node) {}
+    virtual void Visit(ASTStatementWhile& node) {}
+    virtual void Visit(ASTStatementFor& node) {}
+    virtual void Visit(ASTStatementReturn& node) {}
+    virtual void Visit(ASTExpressionInt& node) {}
+    virtual void Visit(ASTExpressionFloat& node) {}
+    virtual void Visit(ASTExpressionBool& node) {}
+    virtual void Visit(ASTExpressionString& node) {}
+    virtual void Visit(ASTExpressionVariable& node) {}
+    virtual void Visit(ASTExpressionCall& node) {}
+    virtual void Visit(ASTExpressionAssignment& node) {}
+    virtual void Visit(ASTExpressionBinary& node) {} // Arithmetic, comparisons, and logic all come here, tell them apart by kind.
+    virtual void Visit(ASTExpressionNegation& node) {}
+    virtual void Visit(ASTExpressionInt2Float& node) {}
+    virtual void Visit(ASTExpressionFloat2Int& node) {}
+    virtual void Visit(ASTExpressionInt2Bool& node) {}
+    virtual void Visit(ASTExpressionBool2Int& node) {}
+
+    // Must make the destructor virtual to make the compiler happy.
+    virtual ~ASTMutator() = default;
+
+};